@@ -6,7 +6,7 @@
 ArgParse - A header-only command line argument parser for C++
 
 Features:
-	* Single file header-only C++11 library (450 lines)
+	* Single file header-only C++11 library
 	* Short form and long form of arguments
 	* Default values for optional arguments
 	* Can nest commands one level deep
@@ -22,8 +22,16 @@ Options have a long name, and an optional single-character short name:
 Options can be boolean, like above, or they can have a value associated with them:
 
 	--outfile filename
+	--outfile=filename
 	-o filename
 
+Short switches can be bundled into one token:
+
+	-fp        same as -f -p
+
+Only the last option in a bundle may take a value (from the next argument, as
+usual).
+
 Anything that is not part of an option is collected in 'Params'
 
 Commands can be added with `AddCommand`. If one or more commands have been defined,
@@ -68,11 +76,65 @@ License: MIT
 
 #include <vector>
 #include <string>
+#include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 #include <unordered_set>
 #include <algorithm>
 #include <functional>
 #include <stdint.h>
+#include <stdarg.h>
+#include <initializer_list>
+#include <utility>
+#include <new>
+#include <thread>
+
+// Platform headers for memory-mapped response files
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// SSE2 is used to scan response-file buffers for token boundaries 16 bytes at a
+// time. Scalar fallback elsewhere (including NEON targets, where the compiler does
+// a decent job on the byte loop).
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ARGPARSE_SSE2 1
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define ARGPARSE_SSE2 0
+#endif
+
+// Opt-in parse instrumentation: compile with -DARGPARSE_STATS and Args::Stats is
+// filled during every Parse/ParseTo/ParseStream. When not defined, the counters and
+// all the code that feeds them compile away to nothing.
+#ifdef ARGPARSE_STATS
+#include <chrono>
+#define ARGPARSE_STAT(x) x
+#else
+#define ARGPARSE_STAT(x)
+#endif
+
+// std::string_view support (used by the optional zero-copy parse mode)
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define ARGPARSE_HAS_STRING_VIEW 1
+#include <string_view>
+#else
+#define ARGPARSE_HAS_STRING_VIEW 0
+#endif
 
 namespace argparse {
 
@@ -80,22 +142,415 @@ class Args;
 
 typedef std::function<int(Args& args)> CmdFunc;
 
+// Deferred registration function for a command (see Args::AddCommand). Invoked at
+// most once, when the command is chosen by Parse() or its help is requested, so a
+// tool with hundreds of commands only pays the setup cost of the one it runs.
+typedef std::function<void(Args& cmd)> SetupFunc;
+
+#ifdef ARGPARSE_STATS
+// Counters describing what the last Parse/ParseTo/ParseStream did, for attaching to
+// service metrics. ParamBytes/ValueBytes measure the argument data that flowed
+// through the parser, which in owning mode is also the data that was copied.
+struct ArgStats {
+	size_t Tokens       = 0; // argv tokens visited
+	size_t OptionHits   = 0; // Tokens that matched a registered option
+	size_t OptionMisses = 0; // Dash-prefixed tokens that matched nothing (help requests, negative numbers, unknown options)
+	size_t Params       = 0; // Positional parameters
+	size_t ParamBytes   = 0; // Total bytes of positional parameter data
+	size_t ValueBytes   = 0; // Total bytes of option value data
+	double ParseSeconds = 0; // Wall time of the parse
+};
+#endif
+
+// Declared type of a value option. Options registered with AddIntValue/AddDoubleValue
+// are converted once during Parse(), and a malformed number fails the parse instead
+// of silently becoming 0.
+enum class ValueType : uint8_t {
+	String,
+	Int,
+	Double,
+};
+
+inline bool IsArgWhitespace(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+#if ARGPARSE_SSE2
+// One bit per byte of p[0..15]: 1 = whitespace
+inline uint32_t WhitespaceMask16(const char* p) {
+	__m128i v  = _mm_loadu_si128((const __m128i*) p);
+	__m128i ws = _mm_or_si128(
+	    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+	    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+	return (uint32_t) _mm_movemask_epi8(ws);
+}
+
+inline uint32_t LowestBit(uint32_t m) {
+#ifdef _MSC_VER
+	unsigned long idx;
+	_BitScanForward(&idx, m);
+	return (uint32_t) idx;
+#else
+	return (uint32_t) __builtin_ctz(m);
+#endif
+}
+#endif
+
+// Position of the first non-whitespace byte at or after 'i', or 'size'
+inline size_t ScanWhitespace(const char* data, size_t size, size_t i) {
+#if ARGPARSE_SSE2
+	while (i + 16 <= size) {
+		uint32_t m = ~WhitespaceMask16(data + i) & 0xffff;
+		if (m)
+			return i + LowestBit(m);
+		i += 16;
+	}
+#endif
+	while (i < size && IsArgWhitespace(data[i]))
+		i++;
+	return i;
+}
+
+// Position of the first whitespace byte at or after 'i', or 'size'
+inline size_t ScanToken(const char* data, size_t size, size_t i) {
+#if ARGPARSE_SSE2
+	while (i + 16 <= size) {
+		uint32_t m = WhitespaceMask16(data + i);
+		if (m)
+			return i + LowestBit(m);
+		i += 16;
+	}
+#endif
+	while (i < size && !IsArgWhitespace(data[i]))
+		i++;
+	return i;
+}
+
+// True if 's' could plausibly be a number, so that negative numbers such as "-1.5"
+// can be treated as positional parameters instead of unknown options.
+inline bool IsNumericToken(const char* s) {
+	for (; *s; s++) {
+		if (!((*s >= '0' && *s <= '9') || *s == '-' || *s == '+' || *s == '.' || *s == 'e'))
+			return false;
+	}
+	return true;
+}
+
+// FNV-1a, used by the interned option-name table. Option names are short, so a
+// simple byte-at-a-time hash beats fancier schemes once setup costs are counted.
+inline uint32_t HashName(const char* s, size_t len) {
+	uint32_t h = 2166136261u;
+	for (size_t i = 0; i < len; i++) {
+		h ^= (uint8_t) s[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+// Where an option's value came from, in ascending precedence. Options may declare
+// an environment variable (SetEnvVar) and a config key (SetConfigKey); after the
+// argv pass, Parse() resolves every declared source in one sweep, and the winner is
+// recorded per option.
+enum class ValueSource : uint8_t {
+	Default,     // Nothing specified the option
+	Config,      // Value came from the config lookup (see SetConfigSource)
+	Env,         // Value came from the declared environment variable
+	CommandLine, // Value came from argv
+};
+
+// Levenshtein distance between a and b if it is <= maxDist, otherwise maxDist + 1.
+// Rows of the DP bail out as soon as every entry exceeds the cutoff, so mismatched
+// names are rejected in a few rows instead of a full length*length scan.
+inline int BoundedEditDistance(const std::string& a, const std::string& b, int maxDist) {
+	size_t la = a.size(), lb = b.size();
+	if ((la > lb ? la - lb : lb - la) > (size_t) maxDist)
+		return maxDist + 1;
+	std::vector<int> prev(lb + 1), cur(lb + 1);
+	for (size_t j = 0; j <= lb; j++)
+		prev[j] = (int) j;
+	for (size_t i = 1; i <= la; i++) {
+		cur[0]     = (int) i;
+		int rowMin = cur[0];
+		for (size_t j = 1; j <= lb; j++) {
+			int c  = std::min(std::min(prev[j] + 1, cur[j - 1] + 1), prev[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1));
+			cur[j] = c;
+			rowMin = std::min(rowMin, c);
+		}
+		if (rowMin > maxDist)
+			return maxDist + 1;
+		std::swap(prev, cur);
+	}
+	return prev[lb] <= maxDist ? prev[lb] : maxDist + 1;
+}
+
+// What went wrong in the last Parse/ParseTo/ParseStream (see Args::LastError).
+enum class ErrorCode : uint8_t {
+	None,
+	HelpShown,       // Not an error: the user asked for help
+	UnknownOption,   // A dash token matched no registered option
+	UnknownCommand,  // The first parameter matched no registered command
+	MissingValue,    // A value option was the last token
+	SwitchHasValue,  // --switch=value on an option that takes no value
+	BadValue,        // A typed (Int/Double) option got a malformed number
+	ParamCount,      // A command got the wrong number of parameters
+	BadResponseFile, // An @response-file could not be opened
+	Aborted,         // A ParseStream callback returned false
+	BadDefinition,   // ValidateSanity rejected the option/command definition
+};
+
+// A structured description of a parse failure. Recording one of these is just a few
+// stores — no formatting, no allocation, no output — so a server rejecting
+// thousands of bad inputs per second (with Quiet set) pays nothing for the message
+// it never prints. Call Args::FormatError() to render it when actually reporting.
+// Token points into the argv (or response-file buffer) of the failed parse, so
+// format the error before discarding those.
+struct ParseError {
+	ErrorCode   Code        = ErrorCode::None;
+	int         ArgIndex    = -1;          // Position in argv of the offending token, if known
+	size_t      OptionIndex = (size_t) -1; // Index into Scope->Options, if the error concerns an option
+	const Args* Scope       = nullptr;     // The Args the error occurred in (a command, or the root)
+	const char* Token       = nullptr;     // The offending text
+	int         Count       = 0;           // For ParamCount: the number of parameters seen
+};
+
 class Option {
 public:
-	bool        ExpectsValue = false; // True if flag has an associated value
+	bool        ExpectsValue = false;             // True if flag has an associated value
+	bool        Accumulate   = false;             // True if every occurrence appends to Values (see AddMultiValue)
+	ValueType   Type         = ValueType::String; // Declared type of the value
 	std::string Short;
 	std::string Long;
 	std::string Summary;
 	std::string Default;
+	std::string EnvVar;    // If set, this environment variable supplies the value when argv does not
+	std::string ConfigKey; // If set, this key is passed to the config lookup when argv and EnvVar do not supply a value
+	int64_t     DefaultInt    = 0; // Default converted to integer at registration time
+	double      DefaultDouble = 0; // Default converted to double at registration time
 
-	bool        Toggled = false; // Set to true if the value is present. Works for Switch and Value options.
+	bool        Toggled = false;                // Set to true if the value is present. Works for Switch and Value options.
+	ValueSource Source  = ValueSource::Default; // Where the current value came from
 	std::string Value;           // Value of option, if ExpectsValue=true
+	int64_t     CachedInt    = 0; // Value converted to integer during Parse(). GetInt/GetInt64 read this.
+	double      CachedDouble = 0; // Value converted to double during Parse(). GetDouble reads this.
+
+	std::vector<std::string> Values; // Accumulated values, one per occurrence, if Accumulate=true
+
+#if ARGPARSE_HAS_STRING_VIEW
+	std::string_view              ValueView;  // Value of option in zero-copy mode. Points into argv.
+	std::vector<std::string_view> ValueViews; // Accumulated values in zero-copy mode. Point into argv.
+#endif
 
 	bool HasShort() const { return Short.length() != 0; }
 
 	bool operator<(const Option& b) const { return Long < b.Long; }
 };
 
+// A pre-resolved option handle (see Args::Handle). Resolve the name once at setup,
+// and Has/Get/GetInt on the handle become a direct indexed access, with no string
+// hashing or comparison on the hot path. Handles stay valid until another option is
+// added to the same Args.
+struct OptionHandle {
+	size_t Index = (size_t) -1;
+
+	bool Valid() const { return Index != (size_t) -1; }
+};
+
+// A statically declarable option descriptor. Option tables that are fully known at
+// compile time can be written once as a static array and handed to the Args
+// constructor, which registers and validates the entire table in a single pass,
+// instead of paying one AddSwitch/AddValue call per option on every process start.
+struct OptionDef {
+	const char* Short;        // "" if there is no short form
+	const char* Long;
+	const char* Summary;
+	const char* Default;      // Ignored for switches
+	bool        ExpectsValue; // false = switch, true = value
+};
+
+// The results of one parse, produced by Args::ParseTo(). A ParseResult owns all of
+// its data and only reads the Args definition, so a server can parse once and have
+// any number of threads query the result concurrently, lock-free, while the Args
+// definition stays reusable for the next parse.
+//
+// Options of the top-level Args are queried via Root, and options of the chosen
+// command (if any) via Cmd:
+//
+//	argparse::ParseResult res;
+//	if (!args.ParseTo(argc, argv, res))
+//		return 1;
+//	if (res.Root.Has("verbose")) { ... }
+class ParseResult {
+public:
+	struct OptionValue {
+		bool        Toggled = false;
+		ValueSource Source  = ValueSource::Default;
+		std::string Value;
+		int64_t     CachedInt    = 0;
+		double      CachedDouble = 0;
+
+		std::vector<std::string> Values; // Accumulated values of a repeated (AddMultiValue) option
+	};
+
+	// The parsed state of one Args object (the top-level object, or the chosen command)
+	struct Scope {
+		const Args*              Def = nullptr; // The definition this scope was parsed against
+		std::vector<OptionValue> Opts;          // Parallel to Def->Options
+		std::vector<std::string> Params;        // Positional parameters
+
+		bool               Has(const std::string& _short_or_long) const;
+		const std::string& Get(const std::string& _short_or_long) const;
+		int                GetInt(const std::string& _short_or_long) const;
+		int64_t            GetInt64(const std::string& _short_or_long) const;
+		double             GetDouble(const std::string& _short_or_long) const;
+		const std::vector<std::string>& GetAll(const std::string& _short_or_long) const;
+		ValueSource                     GetSource(const std::string& _short_or_long) const;
+	};
+
+	Scope       Root;              // State of the top-level options and parameters
+	Scope       Cmd;               // State of the chosen command. Valid if Command != nullptr.
+	const Args* Command = nullptr; // The command that was chosen, or null
+};
+
+// A file mapped copy-on-write into memory, used for @response-file expansion. The
+// mapping is private, so the tokenizer can write NUL terminators into it in place,
+// without copying the file contents and without touching the file on disk. Falls
+// back to a plain heap read where a safe writable mapping is not possible.
+class MappedFile {
+public:
+	char*  Data = nullptr;
+	size_t Size = 0;
+
+	MappedFile() {}
+	MappedFile(MappedFile&& b) {
+		Data     = b.Data;
+		Size     = b.Size;
+		IsHeap   = b.IsHeap;
+		b.Data   = nullptr;
+		b.Size   = 0;
+	}
+	~MappedFile() { Close(); }
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const char* filename) {
+		Close();
+#ifdef _WIN32
+		// A write-copy view cannot guarantee a readable NUL slot beyond the end of
+		// the file, so on Windows we just read the file into the heap.
+		return OpenHeap(filename);
+#else
+		int fd = open(filename, O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat st;
+		if (fstat(fd, &st) != 0) {
+			close(fd);
+			return false;
+		}
+		Size = (size_t) st.st_size;
+		long page = sysconf(_SC_PAGESIZE);
+		if (Size == 0 || (page > 0 && Size % (size_t) page == 0)) {
+			// An empty file, or a size that is an exact multiple of the page size, in
+			// which case there is no zero-filled tail byte to terminate the last token
+			close(fd);
+			return OpenHeap(filename);
+		}
+		void* p = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED)
+			return OpenHeap(filename);
+		Data = (char*) p;
+		return true;
+#endif
+	}
+
+	void Close() {
+		if (!Data)
+			return;
+		if (IsHeap)
+			free(Data);
+#ifndef _WIN32
+		else
+			munmap(Data, Size);
+#endif
+		Data   = nullptr;
+		Size   = 0;
+		IsHeap = false;
+	}
+
+private:
+	bool IsHeap = false;
+
+	bool OpenHeap(const char* filename) {
+		FILE* f = fopen(filename, "rb");
+		if (!f)
+			return false;
+		fseek(f, 0, SEEK_END);
+		long size = ftell(f);
+		fseek(f, 0, SEEK_SET);
+		if (size < 0) {
+			fclose(f);
+			return false;
+		}
+		Data = (char*) malloc((size_t) size + 1);
+		Size = (size_t) size;
+		if (Size != 0 && fread(Data, 1, Size, f) != Size) {
+			fclose(f);
+			Close();
+			return false;
+		}
+		Data[Size] = 0;
+		fclose(f);
+		IsHeap = true;
+		return true;
+	}
+};
+
+// A simple bump allocator: allocations come out of large contiguous blocks, and
+// everything is released in one shot when the arena is destroyed. Point an Args at
+// an arena with SetArena() and child command objects are placed contiguously inside
+// it instead of being individually heap allocated, so a large command tree is built
+// with a handful of mallocs and torn down with a handful of frees.
+// The arena must outlive every Args placed in it: command destructors run when the
+// owning Args is destroyed, so declare the arena before the root Args — the other
+// way around, the commands are destroyed after their storage is already gone.
+class Arena {
+public:
+	~Arena() {
+		Block* b = Head;
+		while (b) {
+			Block* next = b->Next;
+			free(b);
+			b = next;
+		}
+	}
+
+	void* Alloc(size_t bytes) {
+		bytes = (bytes + 15) & ~(size_t) 15;
+		if (!Head || Head->Used + bytes > Head->Cap) {
+			size_t cap   = bytes > BlockSize ? bytes : BlockSize;
+			Block* b     = (Block*) malloc(sizeof(Block) + cap);
+			b->Next      = Head;
+			b->Used      = 0;
+			b->Cap       = cap;
+			Head         = b;
+		}
+		void* p = (char*) (Head + 1) + Head->Used;
+		Head->Used += bytes;
+		return p;
+	}
+
+private:
+	struct Block {
+		Block* Next;
+		size_t Used;
+		size_t Cap;
+	};
+	static const size_t BlockSize = 65536;
+
+	Block* Head = nullptr;
+};
+
 class Args {
 public:
 	std::string              Usage; // Main usage text. Everything before the first \n is the "short" usage text.
@@ -104,50 +559,318 @@ public:
 	std::vector<Args*>       Commands;
 	bool                     WasHelpShown = false; // True if Parse() returns false, and showed help text
 
+	// When true, an argv token of the form @filename is replaced by the whitespace
+	// separated tokens inside that file. The file is memory mapped copy-on-write and
+	// tokenized in place, so no per-token copies are made, and the mappings stay
+	// alive until the next parse (or destruction of this object), which keeps
+	// zero-copy views into them valid. Tokens inside a response file are not
+	// themselves expanded.
+	bool ExpandResponseFiles = false;
+
+	// Quiet mode: parse failures record LastError but render and print nothing, so
+	// rejecting bad input is allocation-free and silent. Render the message later
+	// with FormatError() if it turns out to be worth reporting. Definition errors
+	// (ValidateSanity) still print, since those are bugs in the program, not input.
+	bool Quiet = false;
+
+	// Number of worker threads to use for very large runs of positional parameters
+	// (response-file scale). 0 or 1 parses sequentially. Once the leading option
+	// region is past, positional tokens carry no cross-token state, so a long run
+	// is split into chunks and filled on worker threads, each writing its own span
+	// of ParamViews. Order is preserved. This only takes effect in zero-copy mode,
+	// where the per-token work (the strlen inside the string_view constructor)
+	// parallelizes cleanly; the copying parse stays sequential regardless, because
+	// strings allocated on worker threads are freed on the main thread at the next
+	// Reset, and that cross-thread allocator traffic measures slower than the
+	// single-core fill. Runs shorter than ParallelMinRun always stay sequential,
+	// so this is safe to leave enabled for ordinary argv sizes.
+	unsigned ParallelParamThreads = 0;
+
+	// Minimum run length before ParallelParamThreads kicks in. Below this, thread
+	// launch overhead exceeds the work.
+	static const size_t ParallelMinRun = 65536;
+
+	// What the last Parse/ParseTo/ParseStream failure was. Reset at the start of
+	// every parse. Mutable so that const query paths can record errors too.
+	mutable ParseError LastError;
+
+#ifdef ARGPARSE_STATS
+	ArgStats Stats; // Filled during every Parse/ParseTo/ParseStream
+#endif
+
+#if ARGPARSE_HAS_STRING_VIEW
+	// Zero-copy mode: when ZeroCopy is true, Parse() stores parameters and option
+	// values as string_views pointing directly into argv, instead of copying them
+	// into Params and Option::Value. argv must outlive this object. A full parse
+	// then performs no heap allocation for the argument data.
+	bool                          ZeroCopy = false;
+	std::vector<std::string_view> ParamViews; // Positional parameters, in zero-copy mode
+#endif
+
 	// Command parameters
-	std::string       CmdName;                  // Name of a command
-	std::string       CmdParams;                // Help text describing parameters of command
-	argparse::CmdFunc CmdFunc;                  // Function to execute for command
-	bool              CmdEnforceParams = true;  // If CmdParams text is "<param1> <param2>", then make sure two parameters are passed to command
-	bool              CmdWasChosen     = false; // True if this command was chosen
+	std::string         CmdName;                  // Name of a command
+	std::string         CmdParams;                // Help text describing parameters of command
+	argparse::CmdFunc   CmdFunc;                  // Function to execute for command
+	argparse::SetupFunc CmdSetup;                 // Deferred option registration. Run at most once, when the command is chosen or its help is shown.
+	bool                CmdSetupDone     = false; // True once CmdSetup has run
+	bool                CmdEnforceParams = true;  // If CmdParams text is "<param1> <param2>", then make sure two parameters are passed to command
+	bool                CmdWasChosen     = false; // True if this command was chosen
 
 	Args(std::string usage) : Usage(usage) {}                             // Set main usage text for a command
 	Args(std::string cmdName, std::string usage, argparse::CmdFunc func); // Set title and description for a command
 	~Args();
 
+	// Register a static option table in one pass. Validation is performed here, once,
+	// so that Parse() does not need to re-check the table on every invocation.
+	template <size_t N>
+	Args(std::string usage, const OptionDef (&defs)[N]) : Usage(usage) {
+		AddOptionDefs(defs, N);
+	}
+
 	// Setup
 	void  AddSwitch(std::string _short, std::string _long, std::string summary);                               // Add a binary on/off option that has no value (eg --nocache)
 	void  AddValue(std::string _short, std::string _long, std::string summary, std::string defaultValue = ""); // Add an option that has an associated value (eg -f outfile)
-	Args* AddCommand(std::string name, std::string description, argparse::CmdFunc func = nullptr);             // Add a command
+	void  AddIntValue(std::string _short, std::string _long, std::string summary, std::string defaultValue = "0");    // Add a value option that must be an integer
+	void  AddDoubleValue(std::string _short, std::string _long, std::string summary, std::string defaultValue = "0"); // Add a value option that must be a number
+	void  AddMultiValue(std::string _short, std::string _long, std::string summary);                           // Add a value option that may be given repeatedly. Every occurrence appends to GetAll().
+	void  SetEnvVar(const std::string& _short_or_long, std::string envVar);                                    // Let this environment variable supply the option's value when argv does not
+	void  SetConfigKey(const std::string& _short_or_long, std::string configKey);                              // Let the config lookup supply the option's value when argv and the env do not
+	void  SetConfigSource(std::function<bool(const std::string& key, std::string& value)> lookup);             // Resolver for SetConfigKey keys. Return true and fill 'value' if the key exists.
+	void  AddOptionDefs(const OptionDef* defs, size_t n);                                                      // Add a table of options in one pass, validating once
+	void  AddOptions(std::initializer_list<OptionDef> defs);                                                   // Add a table of options in one pass, eg AddOptions({{"f", "force", "Force", "", false}, ...})
+	Args* AddCommand(std::string name, std::string description, argparse::CmdFunc func = nullptr, argparse::SetupFunc setup = nullptr); // Add a command. If 'setup' is given, it registers the command's options lazily.
+	void  SetArena(Arena* arena);                                                                             // Place command objects added after this call inside 'arena', which must outlive this Args
+
+	// Binary schema. SaveSchema writes the whole definition (usage, options,
+	// commands and their options) as a compact file: fixed-width records plus a
+	// string table. A build-time generator can emit the file once, and at runtime
+	// LoadSchema memory-maps it and builds the same definition in a single
+	// pre-reserved pass - no per-option registration calls, and no validation,
+	// since the table was validated when it was saved. Load into a freshly
+	// constructed Args. Command functions are code, not data: after loading,
+	// attach them with FindCommand(name)->CmdFunc = ...
+	bool SaveSchema(const char* filename);
+	bool LoadSchema(const char* filename);
 
 	// Help
 	void ShowHelp();
 
+	// Redirect all help and error output. By default, output is rendered into a
+	// buffer and flushed to stdout with a single write (a full help screen is one
+	// syscall). A custom sink receives the same buffered chunks, so callers can
+	// route output into their own logging without capturing stdout. The sink is
+	// propagated to all commands, present and future.
+	void SetOutput(std::function<void(const char* text, size_t len)> sink);
+
 	// Parse
 	// startAt: Start parsing at this argument. You normally skip the first argument, because it's typically the name of the program
 	// Returns true if parse succeeded, or false if parse failed, or if help was shown. See WasHelpShown to know if the parse failed
 	// because the user requested help.
 	bool Parse(int argc, const char** argv, int startAt = 1);
 
+#ifdef _WIN32
+	// Native wide-argv entry point, for wmain or CommandLineToArgvW. All arguments
+	// are converted to UTF-8 in one pass into a single contiguous internal buffer
+	// (sized with one measuring scan), so the conversion costs two allocations
+	// regardless of argc, instead of one heap string per argument. The buffer lives
+	// until the next wide parse (or destruction of this object), so zero-copy views
+	// into it stay valid, just like response-file mappings.
+	bool Parse(int argc, const wchar_t** argv, int startAt = 1);
+#endif
+
+	// Parse into a separate, immutable ParseResult instead of mutating the Option
+	// objects. Once ParseTo returns, any number of threads may query the result
+	// concurrently without locks, and this Args can be re-parsed independently.
+	bool ParseTo(int argc, const char** argv, ParseResult& res, int startAt = 1);
+
+	// Streaming parse: every positional parameter is handed to 'onParam' as it is
+	// encountered, instead of being accumulated in Params, so memory use stays
+	// constant no matter how many arguments there are. Options and commands behave
+	// exactly like Parse(). Return false from the callback to abort the parse, in
+	// which case ParseStream returns false.
+	bool ParseStream(int argc, const char** argv, std::function<bool(const char* param)> onParam, int startAt = 1);
+
 	// Results
-	int         ExecCommand();                                      // Execute the command that was chosen. Returns value from exec function.
-	Args*       WhichCommand();                                     // Returns the command that was chosen, or null.
+	int                ExecCommand();                                       // Execute the command that was chosen. Returns value from exec function.
+	Args*              WhichCommand();                                      // Returns the command that was chosen, or null.
+	Args*              FindCommand(const char* name) const;                 // Find a command by exact name, in O(log n)
+	std::vector<Args*> FindCommandsByPrefix(const std::string& prefix) const; // All commands whose name starts with 'prefix', sorted by name
+
+	// Shell completion. TryComplete handles a "--complete [words...]" query (one
+	// candidate per line on the output sink) and returns true if it did, in which
+	// case the caller should exit instead of parsing. The script emitters produce
+	// static bash/zsh snippets that route TAB through --complete, so completing a
+	// keystroke is one O(prefix) index probe instead of a table dump.
+	std::vector<std::string> Complete(const std::string& prefix) const;       // Candidates for 'prefix': command names, or long options if it starts with '-'
+	bool                     TryComplete(int argc, const char** argv, int startAt = 1);
+	std::string              BashCompletionScript(const std::string& progName) const;
+	std::string              ZshCompletionScript(const std::string& progName) const;
 	bool        Has(const std::string& _short_or_long) const;       // Returns true if the option was specified
 	std::string Get(const std::string& _short_or_long) const;       // Get an option's value. Returns default value if not specified.
+#if ARGPARSE_HAS_STRING_VIEW
+	std::string_view GetView(const std::string& _short_or_long) const; // Get an option's value without copying. In zero-copy mode the view points into argv.
+#endif
 	int         GetInt(const std::string& _short_or_long) const;    // Get an option and convert to int. Returns default value if not specified.
 	int64_t     GetInt64(const std::string& _short_or_long) const;  // Get an option and convert to int64. Returns default value if not specified.
 	double      GetDouble(const std::string& _short_or_long) const; // Get an option and convert to double. Returns default value if not specified.
+	const std::vector<std::string>& GetAll(const std::string& _short_or_long) const; // All values of a repeated (AddMultiValue) option, in argv order
+	ValueSource GetSource(const std::string& _short_or_long) const; // Where the option's current value came from (argv, env, config, or default)
+	std::string FormatError() const;                                // Render LastError into the same message an un-Quiet parse would have printed
+#if ARGPARSE_HAS_STRING_VIEW
+	const std::vector<std::string_view>& GetAllViews(const std::string& _short_or_long) const; // Same as GetAll, for zero-copy mode. Views point into argv.
+#endif
+
+	// Handle-based queries, for hot loops. Resolve the handle once with Handle(),
+	// then the queries below are a direct array access.
+	OptionHandle       Handle(const std::string& _short_or_long) const; // Resolve an option name to a handle
+	bool               Has(OptionHandle h) const;
+	const std::string& Get(OptionHandle h) const; // Owning mode only: in zero-copy mode the value lives in a view, so use GetView(h)
+	int                GetInt(OptionHandle h) const;
+	int64_t            GetInt64(OptionHandle h) const;
+	double             GetDouble(OptionHandle h) const;
+	const std::vector<std::string>& GetAll(OptionHandle h) const; // Owning mode only: in zero-copy mode use GetAllViews(h)
+#if ARGPARSE_HAS_STRING_VIEW
+	std::string_view                     GetView(OptionHandle h) const;     // Like Get(h), but works in both modes. In zero-copy mode the view points into argv.
+	const std::vector<std::string_view>& GetAllViews(OptionHandle h) const; // Same as GetAll(h), for zero-copy mode. Views point into argv.
+#endif
 
 private:
-	Option*     FindOption(const char* arg);
-	bool        ValidateSanity(int depth) const;
+	friend class ParseResult;
+
+	// Lookup index over Short and Long names, so that FindOption/Has/Get are O(1)
+	// instead of a linear scan. All names are interned back to back in NamePool,
+	// and NameSlots is an open-addressing hash table of {offset, length, index}
+	// records over the pool, so a probe walks a few adjacent 16-byte slots in one
+	// contiguous allocation and compares against the pool. It never touches the
+	// much larger Option objects (whose Summary/Default/Value bytes are cold until
+	// help or Get needs them), and it needs no temporary std::string for C-string
+	// keys. Rebuilt lazily whenever an option is added.
+	struct NameSlot {
+		uint32_t NameOff = 0; // Byte offset of the name in NamePool
+		uint32_t NameLen = 0; // 0 marks an empty slot
+		uint32_t OptIdx  = 0; // Option index, with NameIsLong set if this is a Long name
+		uint32_t Hash    = 0;
+	};
+	static const uint32_t         NameIsLong = 0x80000000u;
+	static const uint32_t         NameMiss   = 0xffffffffu;
+	mutable std::vector<NameSlot> NameSlots; // Power-of-two sized, linear probing
+	mutable std::vector<char>     NamePool;  // Interned Short and Long names, back to back
+	mutable bool                  NameIndexDirty = true;
+
+	// Command dispatch index: (CmdName, command) pairs sorted by name, so that
+	// command matching and prefix queries are a binary search instead of a scan.
+	mutable std::vector<std::pair<std::string, Args*>> CmdIndex;
+	mutable bool                                       CmdIndexDirty = true;
+
+	bool  SanityCached = false;   // True if ValidateSanity has passed and the definition hasn't changed since
+	Args* ChosenCmd    = nullptr; // The command chosen by the last Parse(), so WhichCommand is O(1)
+
+	// Indexes of options toggled by the last Parse(), so Reset and ConvertTypedValues
+	// touch only those, instead of walking the whole option table every parse
+	std::vector<size_t> Touched;
+
+	// Suggestion index for "did you mean" on unknown names: long option names and
+	// command names bucketed by length, so a probe only runs the edit distance
+	// against candidates within reach (length +/- 2). Rebuilt lazily, like NameIndex.
+	// Long option names, sorted, so Complete() takes a lower_bound prefix range
+	// instead of scanning the option table. Rebuilt lazily, like NameIndex.
+	mutable std::vector<std::string> OptNamesSorted;
+	mutable bool                     OptNamesDirty = true;
+
+	mutable std::vector<std::vector<std::string>> OptSuggestBuckets;
+	mutable std::vector<std::vector<std::string>> CmdSuggestBuckets;
+	mutable bool                                  OptSuggestDirty = true;
+	mutable bool                                  CmdSuggestDirty = true;
+
+	// Indexes of options that declared an env var or config key, so the overlay
+	// sweep after the argv pass only visits those (and costs nothing when unused)
+	std::vector<size_t>                                              OverlayOptions;
+	std::function<bool(const std::string& key, std::string& value)> ConfigLookup;
+
+	std::function<void(const char* text, size_t len)> OutputSink; // Where help and error output goes. Empty = stdout.
+
+	// Rendered help text, cached after first generation and invalidated when the
+	// definition changes, so repeated help display is a single buffer append.
+	// Help for this object renders differently at the top level (depth 0) vs as a
+	// command underneath another Args (depth 1), hence two slots.
+	std::string HelpCache[2];
+	bool        HelpCacheValid[2] = {false, false};
+	Arena*                                          CmdArena       = nullptr; // If set, command objects are placed in this arena
+	bool                                            InArena        = false;   // True if this object itself was placed in an arena
+	std::vector<MappedFile>                         RespFiles;                // Mappings backing expanded @response-file tokens
+	std::vector<const char*>                        RespArgv;                 // argv after @response-file expansion
+#ifdef _WIN32
+	std::vector<char>                               WideArgvBuf;              // UTF-8 conversions of a wide argv, back to back
+	std::vector<const char*>                        WideArgv;                 // Pointers into WideArgvBuf, one per argument
+#endif
+
+	friend struct ParseResult::Scope;
+
+	struct MutatingSink;
+	struct ResultSink;
+	struct StreamSink;
+
+	// On-disk schema layout (see SaveSchema/LoadSchema). String fields are byte
+	// offsets of NUL-terminated strings in the string table at the end of the file.
+	struct SchemaHeader {
+		char     Magic[4];      // "APSB"
+		uint32_t Version;       // 1
+		uint32_t TotalOptions;  // Option records in the file, root's first
+		uint32_t RootOptions;   // Of which the first N belong to the root
+		uint32_t NumCommands;   // Command records follow the option records
+		uint32_t StringsOffset; // Byte offset of the string table
+		uint32_t StringsSize;   // Byte size of the string table
+		uint32_t UsageRef;      // Usage text
+	};
+	struct SchemaOption {
+		uint32_t Short, Long, Summary, Default, EnvVar, ConfigKey;
+		uint8_t  ExpectsValue, Accumulate, Type, Pad;
+	};
+	struct SchemaCommand {
+		uint32_t Name, Params, Description;
+		uint32_t FirstOption, NumOptions; // Range of option records belonging to this command
+	};
+
+	void          BuildNameIndex() const;
+	void          BuildCmdIndex() const;
+	size_t        FindIndexByName(const std::string& _short_or_long) const; // Returns -1 if not found
+	const Option* FindByName(const std::string& _short_or_long) const;
+	Option*       FindOption(const char* arg);
+	uint32_t      ProbeName(const char* name, size_t len) const; // Probe the interned-name table. Returns packed OptIdx (NameIsLong set for a long-name match), or NameMiss.
+	size_t        FindOptionIndex(const char* arg) const; // Find by command-line token (eg "-f" or "--force"). Returns -1 if not found.
+	size_t        FindLongIndex(const char* name, size_t len) const; // Find by long name of known length (the name part of "--opt=value"). Returns -1 if not found.
+	size_t        FindShortIndex(char c) const;           // Find by single short character (for bundled "-abc"). Returns -1 if not found.
+	std::string   SuggestOption(const std::string& name) const;  // Closest registered long name within edit distance 2, or ""
+	std::string   SuggestCommand(const std::string& name) const; // Closest registered command name within edit distance 2, or ""
+	static std::string SuggestFrom(const std::vector<std::vector<std::string>>& buckets, const std::string& name);
+	void          AddValueInternal(std::string _short, std::string _long, std::string summary, std::string defaultValue, ValueType type);
+	bool          ConvertTypedValues();
+	void          ApplyOverlays();
+	bool          EnsureSetup();
+	bool          ExpandArgv(int& argc, const char**& argv);
+	static void   TokenizeBuffer(char* data, size_t size, std::vector<const char*>& tokens);
+	bool          ValidateSanity(int depth) const;
+	static bool   ConvertNumeric(const char* s, int64_t& intVal, double& dblVal);
+
+	// The parse loop, shared by Parse() and ParseTo(). The sink decides where parsed
+	// state is written to (into the Option objects, or into a ParseResult).
+	template <typename TSink>
+	bool ParseCore(int argc, const char** argv, int startAt, TSink& sink);
 	void        Reset();
 	void        ShowHelpInternal(int depth, std::string forCmd);
+	void        RenderHelp(int depth, const std::string& forCmd, std::string& buf);
+	void        RenderHelpUncached(int depth, std::string& buf);
+	void        InvalidateHelpCache();
+	void        Emit(const std::string& text) const;       // Send a rendered chunk to the sink (or stdout) in one write
+	void        Errorf(const char* fmt, ...) const;        // Format an error message and Emit it
+	bool        Fail(ErrorCode code, int argIndex, size_t optionIndex, const char* token, const Args* scope, int count = 0) const; // Record LastError, print it unless Quiet. Always returns false.
+	std::string RenderError(const ParseError& e) const;    // The message for 'e' (suggestion probes run here, not on the hot path)
 	std::string UsageShort() const;     // Returns everything before the first \n from Usage
 	std::string UsageDetails() const;   // Returns everything after the first \n from Usage
 	size_t      CmdParamsCount() const; // If CmdParams is "<param1> <param2>" then return 2 (ie the number of objects inside <angled brackets>)
-	static void WriteFormattedText(int indent, std::string text, int lineLength);
-	static bool IsNumeric(const char* s);
+	static void AppendFmt(std::string& buf, const char* fmt, ...);
+	static void AppendFmtV(std::string& buf, const char* fmt, va_list va);
+	static void WriteFormattedText(int indent, std::string text, int lineLength, std::string& buf);
 };
 
 inline Args::Args(std::string cmdName, std::string usage, argparse::CmdFunc func) : Usage(usage), CmdFunc(func) {
@@ -162,39 +885,422 @@ inline Args::Args(std::string cmdName, std::string usage, argparse::CmdFunc func
 }
 
 inline Args::~Args() {
-	for (auto a : Commands)
-		delete a;
+	for (auto a : Commands) {
+		if (a->InArena)
+			a->~Args(); // memory itself is released by the arena, in one shot
+		else
+			delete a;
+	}
+}
+
+inline bool Args::SaveSchema(const char* filename) {
+	// Lazy commands must be materialized before their options can be written
+	for (auto c : Commands) {
+		if (!c->EnsureSetup())
+			return false;
+	}
+
+	std::string table;
+	auto        addStr = [&table](const std::string& s) -> uint32_t {
+		uint32_t off = (uint32_t) table.size();
+		table.append(s.c_str(), s.size() + 1);
+		return off;
+	};
+	auto addOpt = [&addStr](const Option& opt) -> SchemaOption {
+		SchemaOption so;
+		so.Short        = addStr(opt.Short);
+		so.Long         = addStr(opt.Long);
+		so.Summary      = addStr(opt.Summary);
+		so.Default      = addStr(opt.Default);
+		so.EnvVar       = addStr(opt.EnvVar);
+		so.ConfigKey    = addStr(opt.ConfigKey);
+		so.ExpectsValue = opt.ExpectsValue ? 1 : 0;
+		so.Accumulate   = opt.Accumulate ? 1 : 0;
+		so.Type         = (uint8_t) opt.Type;
+		so.Pad          = 0;
+		return so;
+	};
+
+	SchemaHeader h = {};
+	memcpy(h.Magic, "APSB", 4);
+	h.Version  = 1;
+	h.UsageRef = addStr(Usage);
+
+	std::vector<SchemaOption>  opts;
+	std::vector<SchemaCommand> cmds;
+	for (const auto& opt : Options)
+		opts.push_back(addOpt(opt));
+	h.RootOptions = (uint32_t) opts.size();
+	for (auto c : Commands) {
+		SchemaCommand sc;
+		sc.Name        = addStr(c->CmdName);
+		sc.Params      = addStr(c->CmdParams);
+		sc.Description = addStr(c->Usage);
+		sc.FirstOption = (uint32_t) opts.size();
+		sc.NumOptions  = (uint32_t) c->Options.size();
+		for (const auto& opt : c->Options)
+			opts.push_back(addOpt(opt));
+		cmds.push_back(sc);
+	}
+	h.TotalOptions  = (uint32_t) opts.size();
+	h.NumCommands   = (uint32_t) cmds.size();
+	h.StringsOffset = (uint32_t) (sizeof(h) + opts.size() * sizeof(SchemaOption) + cmds.size() * sizeof(SchemaCommand));
+	h.StringsSize   = (uint32_t) table.size();
+
+	FILE* f = fopen(filename, "wb");
+	if (!f) {
+		Errorf("Cannot write schema file '%s'\n", filename);
+		return false;
+	}
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+	if (opts.size() != 0)
+		ok = ok && fwrite(opts.data(), sizeof(SchemaOption), opts.size(), f) == opts.size();
+	if (cmds.size() != 0)
+		ok = ok && fwrite(cmds.data(), sizeof(SchemaCommand), cmds.size(), f) == cmds.size();
+	ok = ok && fwrite(table.data(), 1, table.size(), f) == table.size();
+	fclose(f);
+	return ok;
+}
+
+inline bool Args::LoadSchema(const char* filename) {
+	MappedFile mf;
+	if (!mf.Open(filename) || mf.Size < sizeof(SchemaHeader)) {
+		Errorf("Cannot open schema file '%s'\n", filename);
+		return false;
+	}
+	const SchemaHeader* h = (const SchemaHeader*) mf.Data;
+	size_t              recEnd = sizeof(SchemaHeader) + (size_t) h->TotalOptions * sizeof(SchemaOption) + (size_t) h->NumCommands * sizeof(SchemaCommand);
+	if (memcmp(h->Magic, "APSB", 4) != 0 || h->Version != 1 ||
+	    h->RootOptions > h->TotalOptions || h->StringsOffset != recEnd ||
+	    (size_t) h->StringsOffset + h->StringsSize > mf.Size ||
+	    h->StringsSize == 0 || h->UsageRef >= h->StringsSize ||
+	    mf.Data[h->StringsOffset + h->StringsSize - 1] != 0) {
+		Errorf("'%s' is not a valid schema file\n", filename);
+		return false;
+	}
+	const SchemaOption*  opts = (const SchemaOption*) (mf.Data + sizeof(SchemaHeader));
+	const SchemaCommand* cmds = (const SchemaCommand*) (mf.Data + sizeof(SchemaHeader) + (size_t) h->TotalOptions * sizeof(SchemaOption));
+	const char*          strs = mf.Data + h->StringsOffset;
+	// Every string ref must land inside the table; the table's trailing NUL (checked
+	// above) then bounds each string
+	for (uint32_t i = 0; i < h->TotalOptions; i++) {
+		const SchemaOption& so = opts[i];
+		if (so.Short >= h->StringsSize || so.Long >= h->StringsSize || so.Summary >= h->StringsSize ||
+		    so.Default >= h->StringsSize || so.EnvVar >= h->StringsSize || so.ConfigKey >= h->StringsSize) {
+			Errorf("'%s' is not a valid schema file\n", filename);
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < h->NumCommands; i++) {
+		const SchemaCommand& sc = cmds[i];
+		if (sc.Name >= h->StringsSize || sc.Params >= h->StringsSize || sc.Description >= h->StringsSize ||
+		    (size_t) sc.FirstOption + sc.NumOptions > h->TotalOptions || sc.FirstOption < h->RootOptions) {
+			Errorf("'%s' is not a valid schema file\n", filename);
+			return false;
+		}
+	}
+
+	auto loadOpts = [strs](Args* dst, const SchemaOption* src, uint32_t n) {
+		dst->Options.reserve(dst->Options.size() + n);
+		for (uint32_t i = 0; i < n; i++) {
+			const SchemaOption& so = src[i];
+			Option              opt;
+			opt.ExpectsValue = so.ExpectsValue != 0;
+			opt.Accumulate   = so.Accumulate != 0;
+			opt.Type         = (ValueType) so.Type;
+			opt.Short        = strs + so.Short;
+			opt.Long         = strs + so.Long;
+			opt.Summary      = strs + so.Summary;
+			opt.Default      = strs + so.Default;
+			opt.EnvVar       = strs + so.EnvVar;
+			opt.ConfigKey    = strs + so.ConfigKey;
+			if (!opt.EnvVar.empty() || !opt.ConfigKey.empty())
+				dst->OverlayOptions.push_back(dst->Options.size());
+			ConvertNumeric(opt.Default.c_str(), opt.DefaultInt, opt.DefaultDouble);
+			opt.CachedInt    = opt.DefaultInt;
+			opt.CachedDouble = opt.DefaultDouble;
+			dst->Options.push_back(std::move(opt));
+		}
+		dst->NameIndexDirty  = true;
+		dst->OptSuggestDirty = true;
+		dst->OptNamesDirty   = true;
+		// The table was validated when it was saved, so the loaded definition does
+		// not need to be re-checked
+		dst->SanityCached = true;
+	};
+
+	Usage = strs + h->UsageRef;
+	loadOpts(this, opts, h->RootOptions);
+	for (uint32_t i = 0; i < h->NumCommands; i++) {
+		const SchemaCommand& sc   = cmds[i];
+		std::string          spec = strs + sc.Name;
+		if (strs[sc.Params] != 0)
+			spec += std::string(" ") + (strs + sc.Params);
+		Args* c = AddCommand(spec, strs + sc.Description);
+		loadOpts(c, opts + sc.FirstOption, sc.NumOptions);
+	}
+	SanityCached = true;
+	InvalidateHelpCache();
+	return true;
+}
+
+inline void Args::SetArena(Arena* arena) {
+	CmdArena = arena;
 }
 
 inline void Args::AddSwitch(std::string _short, std::string _long, std::string summary) {
 	Option opt;
 	opt.ExpectsValue = false;
-	opt.Short        = _short;
-	opt.Long         = _long;
-	opt.Summary      = summary;
+	opt.Short        = std::move(_short);
+	opt.Long         = std::move(_long);
+	opt.Summary      = std::move(summary);
 	opt.Default      = "0";
-	Options.push_back(opt);
+	Options.push_back(std::move(opt));
+	NameIndexDirty  = true;
+	OptSuggestDirty = true;
+	OptNamesDirty   = true;
+	SanityCached    = false;
+	InvalidateHelpCache();
 }
 
 inline void Args::AddValue(std::string _short, std::string _long, std::string summary, std::string defaultValue) {
+	AddValueInternal(std::move(_short), std::move(_long), std::move(summary), std::move(defaultValue), ValueType::String);
+}
+
+inline void Args::AddIntValue(std::string _short, std::string _long, std::string summary, std::string defaultValue) {
+	AddValueInternal(std::move(_short), std::move(_long), std::move(summary), std::move(defaultValue), ValueType::Int);
+}
+
+inline void Args::AddDoubleValue(std::string _short, std::string _long, std::string summary, std::string defaultValue) {
+	AddValueInternal(std::move(_short), std::move(_long), std::move(summary), std::move(defaultValue), ValueType::Double);
+}
+
+inline void Args::AddMultiValue(std::string _short, std::string _long, std::string summary) {
+	AddValueInternal(std::move(_short), std::move(_long), std::move(summary), "", ValueType::String);
+	Options.back().Accumulate = true;
+}
+
+inline void Args::SetEnvVar(const std::string& _short_or_long, std::string envVar) {
+	size_t i = FindIndexByName(_short_or_long);
+	if (i == (size_t) -1) {
+		Errorf("Option %s does not exist\n", _short_or_long.c_str());
+		return;
+	}
+	if (Options[i].EnvVar.empty() && Options[i].ConfigKey.empty())
+		OverlayOptions.push_back(i);
+	Options[i].EnvVar = std::move(envVar);
+}
+
+inline void Args::SetConfigKey(const std::string& _short_or_long, std::string configKey) {
+	size_t i = FindIndexByName(_short_or_long);
+	if (i == (size_t) -1) {
+		Errorf("Option %s does not exist\n", _short_or_long.c_str());
+		return;
+	}
+	if (Options[i].EnvVar.empty() && Options[i].ConfigKey.empty())
+		OverlayOptions.push_back(i);
+	Options[i].ConfigKey = std::move(configKey);
+}
+
+inline void Args::SetConfigSource(std::function<bool(const std::string& key, std::string& value)> lookup) {
+	ConfigLookup = std::move(lookup);
+}
+
+inline void Args::AddValueInternal(std::string _short, std::string _long, std::string summary, std::string defaultValue, ValueType type) {
 	Option opt;
 	opt.ExpectsValue = true;
-	opt.Short        = _short;
-	opt.Long         = _long;
-	opt.Summary      = summary;
-	opt.Default      = defaultValue;
-	Options.push_back(opt);
+	opt.Type         = type;
+	opt.Short        = std::move(_short);
+	opt.Long         = std::move(_long);
+	opt.Summary      = std::move(summary);
+	opt.Default      = std::move(defaultValue);
+	ConvertNumeric(opt.Default.c_str(), opt.DefaultInt, opt.DefaultDouble);
+	opt.CachedInt    = opt.DefaultInt;
+	opt.CachedDouble = opt.DefaultDouble;
+	Options.push_back(std::move(opt));
+	NameIndexDirty  = true;
+	OptSuggestDirty = true;
+	OptNamesDirty   = true;
+	SanityCached    = false;
+	InvalidateHelpCache();
+}
+
+inline void Args::AddOptionDefs(const OptionDef* defs, size_t n) {
+	Options.reserve(Options.size() + n);
+	for (size_t i = 0; i < n; i++) {
+		Option opt;
+		opt.ExpectsValue = defs[i].ExpectsValue;
+		opt.Short        = defs[i].Short;
+		opt.Long         = defs[i].Long;
+		opt.Summary      = defs[i].Summary;
+		opt.Default      = defs[i].ExpectsValue ? defs[i].Default : "0";
+		ConvertNumeric(opt.Default.c_str(), opt.DefaultInt, opt.DefaultDouble);
+		opt.CachedInt    = opt.DefaultInt;
+		opt.CachedDouble = opt.DefaultDouble;
+		Options.push_back(std::move(opt));
+	}
+	NameIndexDirty  = true;
+	OptSuggestDirty = true;
+	OptNamesDirty   = true;
+	InvalidateHelpCache();
+	// Validate up front (failures print immediately), so that every subsequent
+	// Parse() can skip the duplicate scan entirely.
+	SanityCached = ValidateSanity(0);
 }
 
-inline Args* Args::AddCommand(std::string name, std::string description, argparse::CmdFunc func) {
-	Commands.push_back(new Args(name, description, func));
+inline void Args::AddOptions(std::initializer_list<OptionDef> defs) {
+	AddOptionDefs(defs.begin(), defs.size());
+}
+
+inline Args* Args::AddCommand(std::string name, std::string description, argparse::CmdFunc func, argparse::SetupFunc setup) {
+	if (CmdArena) {
+		Args* cmd     = new (CmdArena->Alloc(sizeof(Args))) Args(name, description, func);
+		cmd->InArena  = true;
+		cmd->CmdArena = CmdArena;
+		Commands.push_back(cmd);
+	} else {
+		Commands.push_back(new Args(name, description, func));
+	}
+	Commands.back()->CmdSetup   = setup;
+	Commands.back()->OutputSink = OutputSink;
+	Commands.back()->Quiet      = Quiet;
+	SanityCached                = false;
+	CmdIndexDirty               = true;
+	CmdSuggestDirty             = true;
+	InvalidateHelpCache();
 	return Commands.back();
 }
 
+inline bool Args::EnsureSetup() {
+	if (CmdSetup && !CmdSetupDone) {
+		CmdSetupDone = true;
+		CmdSetup(*this);
+		// The freshly registered options were not seen by the top-level sanity
+		// check, so validate them now, once
+		if (!ValidateSanity(1))
+			return false;
+		SanityCached = true;
+	}
+	return true;
+}
+
 inline void Args::ShowHelp() {
 	ShowHelpInternal(0, "");
 }
 
+inline void Args::SetOutput(std::function<void(const char* text, size_t len)> sink) {
+	OutputSink = sink;
+	for (auto c : Commands)
+		c->SetOutput(sink);
+}
+
+inline bool Args::Fail(ErrorCode code, int argIndex, size_t optionIndex, const char* token, const Args* scope, int count) const {
+	LastError.Code        = code;
+	LastError.ArgIndex    = argIndex;
+	LastError.OptionIndex = optionIndex;
+	LastError.Scope       = scope;
+	LastError.Token       = token;
+	LastError.Count       = count;
+	if (!Quiet)
+		Emit(RenderError(LastError));
+	return false;
+}
+
+inline std::string Args::FormatError() const {
+	return RenderError(LastError);
+}
+
+inline std::string Args::RenderError(const ParseError& e) const {
+	std::string   buf;
+	const Option* opt = e.Scope && e.OptionIndex != (size_t) -1 ? &e.Scope->Options[e.OptionIndex] : nullptr;
+	switch (e.Code) {
+	case ErrorCode::UnknownOption: {
+		// The suggestion probe runs here, at message-rendering time, not when the
+		// error was recorded
+		const char* bare = e.Token;
+		while (*bare == '-')
+			bare++;
+		const char* eq   = strchr(bare, '=');
+		std::string sugg = e.Scope->SuggestOption(eq ? std::string(bare, eq - bare) : std::string(bare));
+		if (sugg != "")
+			AppendFmt(buf, "\033[1;31mUnknown option '%s'. Did you mean \033[0;32m--%s\033[1;31m?\033[0m\n", e.Token, sugg.c_str());
+		else
+			AppendFmt(buf, "\033[1;31mUnknown option '%s'\033[0m\n", e.Token);
+		break;
+	}
+	case ErrorCode::UnknownCommand: {
+		std::string sugg = e.Scope->SuggestCommand(e.Token);
+		if (sugg != "")
+			AppendFmt(buf, "\033[1;31mUnknown command '%s'. Did you mean \033[0;32m%s\033[1;31m?\033[0m\n", e.Token, sugg.c_str());
+		else
+			AppendFmt(buf, "\033[1;31mUnknown command '%s'\033[0m\n", e.Token);
+		break;
+	}
+	case ErrorCode::MissingValue:
+		AppendFmt(buf, "\033[1;31mOption %s expects a value, eg \033[0;32m--%s <something>\033[0m\n", e.Token, opt->Long.c_str());
+		break;
+	case ErrorCode::SwitchHasValue:
+		AppendFmt(buf, "\033[1;31mOption --%s is a switch, and does not take a value\033[0m\n", opt->Long.c_str());
+		break;
+	case ErrorCode::BadValue:
+		AppendFmt(buf, "\033[1;31mOption --%s expects a number, but got '%s'\033[0m\n", opt->Long.c_str(), e.Token);
+		break;
+	case ErrorCode::ParamCount:
+		AppendFmt(buf, "\033[1;31m%s expects %d parameters: %s, but there are %d parameters\033[0m\n", e.Scope->CmdName.c_str(), (int) e.Scope->CmdParamsCount(), e.Scope->CmdParams.c_str(), e.Count);
+		break;
+	case ErrorCode::BadResponseFile:
+		AppendFmt(buf, "\033[1;31mCannot open response file '%s'\033[0m\n", e.Token);
+		break;
+	case ErrorCode::BadDefinition:
+		AppendFmt(buf, "\033[1;31mInvalid option/command definition\033[0m\n");
+		break;
+	case ErrorCode::None:
+	case ErrorCode::HelpShown:
+	case ErrorCode::Aborted:
+		break;
+	}
+	return buf;
+}
+
+inline void Args::Emit(const std::string& text) const {
+	if (OutputSink)
+		OutputSink(text.c_str(), text.size());
+	else
+		fwrite(text.c_str(), 1, text.size(), stdout);
+}
+
+inline void Args::AppendFmtV(std::string& buf, const char* fmt, va_list va) {
+	char    tmp[512];
+	va_list va2;
+	va_copy(va2, va);
+	int n = vsnprintf(tmp, sizeof(tmp), fmt, va);
+	if (n >= 0 && (size_t) n < sizeof(tmp)) {
+		buf.append(tmp, (size_t) n);
+	} else if (n >= 0) {
+		size_t old = buf.size();
+		buf.resize(old + (size_t) n + 1);
+		vsnprintf(&buf[old], (size_t) n + 1, fmt, va2);
+		buf.resize(old + (size_t) n);
+	}
+	va_end(va2);
+}
+
+inline void Args::AppendFmt(std::string& buf, const char* fmt, ...) {
+	va_list va;
+	va_start(va, fmt);
+	AppendFmtV(buf, fmt, va);
+	va_end(va);
+}
+
+inline void Args::Errorf(const char* fmt, ...) const {
+	std::string buf;
+	va_list     va;
+	va_start(va, fmt);
+	AppendFmtV(buf, fmt, va);
+	va_end(va);
+	Emit(buf);
+}
+
 inline std::string Args::UsageShort() const {
 	return Usage.substr(0, Usage.find('\n'));
 }
@@ -213,91 +1319,626 @@ inline size_t Args::CmdParamsCount() const {
 		if (CmdParams[i] == '<')
 			count++;
 	}
-	return count;
-}
+	return count;
+}
+
+// Append 'count' argv tokens to 'dst', splitting the work across up to 'threads'
+// worker threads. The vector is resized up front and each thread assigns into its
+// own disjoint span, so order is preserved and no locking is needed. TStr is
+// std::string (copying parse) or std::string_view (zero-copy parse, where the
+// per-token cost is the strlen inside the string_view constructor).
+template <typename TStr>
+inline void ParallelFillTokens(std::vector<TStr>& dst, const char* const* src, size_t count, unsigned threads) {
+	size_t base = dst.size();
+	dst.resize(base + count);
+	// Don't spin up threads for less than ~16k tokens each
+	unsigned maxUseful = (unsigned) (count / 16384);
+	if (threads > maxUseful)
+		threads = maxUseful;
+	if (threads <= 1) {
+		for (size_t k = 0; k < count; k++)
+			dst[base + k] = src[k];
+		return;
+	}
+	std::vector<std::thread> pool;
+	size_t                   chunk = (count + threads - 1) / threads;
+	for (unsigned t = 0; t < threads; t++) {
+		size_t lo = (size_t) t * chunk;
+		size_t hi = lo + chunk < count ? lo + chunk : count;
+		if (lo >= hi)
+			break;
+		TStr*              out = dst.data() + base;
+		const char* const* in  = src;
+		pool.push_back(std::thread([out, in, lo, hi]() {
+			for (size_t k = lo; k < hi; k++)
+				out[k] = in[k];
+		}));
+	}
+	for (size_t t = 0; t < pool.size(); t++)
+		pool[t].join();
+}
+
+// Sink that writes parsed state into the Option objects themselves (classic Parse)
+struct Args::MutatingSink {
+	bool OnOption(Args* scope, size_t oi, const char* value) {
+		Option& opt = scope->Options[oi];
+		if (!opt.Toggled)
+			scope->Touched.push_back(oi);
+		opt.Source = ValueSource::CommandLine;
+		if (value && opt.Accumulate) {
+			// Repeated options append. std::vector grows geometrically, so thousands of
+			// occurrences are amortized O(1) each.
+#if ARGPARSE_HAS_STRING_VIEW
+			if (scope->ZeroCopy)
+				opt.ValueViews.push_back(value);
+			else
+				opt.Values.push_back(value);
+#else
+			opt.Values.push_back(value);
+#endif
+		} else if (value) {
+#if ARGPARSE_HAS_STRING_VIEW
+			if (scope->ZeroCopy)
+				opt.ValueView = value;
+			else
+				opt.Value = value;
+#else
+			opt.Value = value;
+#endif
+		}
+		opt.Toggled = true;
+		return true;
+	}
+	bool OnCommand(Args* root, Args* c) {
+		c->CmdWasChosen = true;
+		root->ChosenCmd = c;
+		c->Quiet        = root->Quiet; // so errors raised in the command's scope stay silent too
+#if ARGPARSE_HAS_STRING_VIEW
+		c->ZeroCopy = root->ZeroCopy;
+#endif
+		return true;
+	}
+	bool OnParam(Args* scope, const char* arg) {
+#if ARGPARSE_HAS_STRING_VIEW
+		if (scope->ZeroCopy) {
+			scope->ParamViews.push_back(arg);
+			return true;
+		}
+#endif
+		scope->Params.push_back(arg);
+		return true;
+	}
+	bool OnParamRun(Args* scope, const char* const* argv, size_t count, unsigned threads) {
+#if ARGPARSE_HAS_STRING_VIEW
+		if (scope->ZeroCopy) {
+			ParallelFillTokens(scope->ParamViews, argv, count, threads);
+			return true;
+		}
+#endif
+		// Copying fills stay sequential: strings allocated on worker threads would be
+		// freed on the main thread at the next Reset, and that cross-thread allocator
+		// traffic measures slower than the single-core fill
+		ParallelFillTokens(scope->Params, argv, count, 1);
+		return true;
+	}
+	size_t ParamCount(Args* scope) {
+#if ARGPARSE_HAS_STRING_VIEW
+		if (scope->ZeroCopy)
+			return scope->ParamViews.size();
+#endif
+		return scope->Params.size();
+	}
+	bool Finish(Args* root, Args* cmd) {
+		root->ApplyOverlays();
+		if (cmd)
+			cmd->ApplyOverlays();
+		if (!root->ConvertTypedValues())
+			return false;
+		if (cmd && !cmd->ConvertTypedValues()) {
+			root->LastError = cmd->LastError;
+			return false;
+		}
+		return true;
+	}
+};
+
+// Sink that writes parsed state into a ParseResult, leaving the definition untouched
+struct Args::ResultSink {
+	ParseResult* Res = nullptr;
+
+	ParseResult::Scope& ScopeFor(Args* scope) {
+		return scope == Res->Root.Def ? Res->Root : Res->Cmd;
+	}
+	bool OnOption(Args* scope, size_t oi, const char* value) {
+		auto& ov = ScopeFor(scope).Opts[oi];
+		if (value && scope->Options[oi].Accumulate)
+			ov.Values.push_back(value);
+		else if (value)
+			ov.Value = value;
+		ov.Toggled = true;
+		ov.Source  = ValueSource::CommandLine;
+		return true;
+	}
+	bool OnCommand(Args* root, Args* c) {
+		Res->Command = c;
+		Res->Cmd.Def = c;
+		c->Quiet     = root->Quiet; // so errors raised in the command's scope stay silent too
+		Res->Cmd.Opts.assign(c->Options.size(), ParseResult::OptionValue());
+		// Build the command's name index now, so that concurrent queries on the
+		// result don't race on the lazy build
+		if (c->NameIndexDirty)
+			c->BuildNameIndex();
+		return true;
+	}
+	bool OnParam(Args* scope, const char* arg) {
+		ScopeFor(scope).Params.push_back(arg);
+		return true;
+	}
+	bool OnParamRun(Args* scope, const char* const* argv, size_t count, unsigned threads) {
+		// Sequential for the same reason as MutatingSink: the fill is allocator-bound
+		ParallelFillTokens(ScopeFor(scope).Params, argv, count, 1);
+		return true;
+	}
+	size_t ParamCount(Args* scope) {
+		return ScopeFor(scope).Params.size();
+	}
+	bool Finish(Args* root, Args* cmd) {
+		if (!FinishScope(Res->Root))
+			return false;
+		if (Res->Command && !FinishScope(Res->Cmd)) {
+			root->LastError = Res->Cmd.Def->LastError;
+			return false;
+		}
+		return true;
+	}
+	bool FinishScope(ParseResult::Scope& s) {
+		// Env/config overlay, mirroring Args::ApplyOverlays but writing into the result
+		for (size_t oi : s.Def->OverlayOptions) {
+			const Option& def = s.Def->Options[oi];
+			auto&         ov  = s.Opts[oi];
+			if (ov.Toggled)
+				continue;
+			const char* env = def.EnvVar.empty() ? nullptr : getenv(def.EnvVar.c_str());
+			std::string cfg;
+			if (env) {
+				ov.Value  = env;
+				ov.Source = ValueSource::Env;
+			} else if (!def.ConfigKey.empty() && s.Def->ConfigLookup && s.Def->ConfigLookup(def.ConfigKey, cfg)) {
+				ov.Value  = cfg;
+				ov.Source = ValueSource::Config;
+			} else {
+				continue;
+			}
+			ov.Toggled = true;
+		}
+		for (size_t i = 0; i < s.Opts.size(); i++) {
+			const Option& def = s.Def->Options[i];
+			auto&         ov  = s.Opts[i];
+			if (!def.ExpectsValue) {
+				ov.CachedInt    = ov.Toggled ? 1 : 0;
+				ov.CachedDouble = ov.Toggled ? 1 : 0;
+				continue;
+			}
+			const char* str = ov.Toggled ? ov.Value.c_str() : def.Default.c_str();
+			bool        ok  = ConvertNumeric(str, ov.CachedInt, ov.CachedDouble);
+			if (!ok && def.Type != ValueType::String)
+				return s.Def->Fail(ErrorCode::BadValue, -1, i, str, s.Def);
+		}
+		return true;
+	}
+};
+
+// Sink that forwards positional parameters to a user callback instead of storing
+// them. Options and commands are handled exactly like Parse().
+struct Args::StreamSink {
+	MutatingSink                            Base;
+	const std::function<bool(const char*)>* OnParamFn = nullptr;
+	size_t                                  NumParams = 0;
+
+	bool OnOption(Args* scope, size_t oi, const char* value) {
+		return Base.OnOption(scope, oi, value);
+	}
+	bool OnCommand(Args* root, Args* c) {
+		return Base.OnCommand(root, c);
+	}
+	bool OnParam(Args* scope, const char* arg) {
+		NumParams++;
+		return (*OnParamFn)(arg);
+	}
+	bool OnParamRun(Args* scope, const char* const* argv, size_t count, unsigned threads) {
+		// The callback sees tokens one at a time and can abort, so order and abort
+		// semantics force this to stay sequential.
+		for (size_t k = 0; k < count; k++) {
+			if (!OnParam(scope, argv[k]))
+				return false;
+		}
+		return true;
+	}
+	size_t ParamCount(Args* scope) {
+		return NumParams;
+	}
+	bool Finish(Args* root, Args* cmd) {
+		return Base.Finish(root, cmd);
+	}
+};
 
-inline bool Args::Parse(int argc, const char** argv, int startAt) {
-	if (!ValidateSanity(0))
-		return false;
-	Reset();
+template <typename TSink>
+inline bool Args::ParseCore(int argc, const char** argv, int startAt, TSink& sink) {
 	Args* cmd = nullptr;
 	for (int i = startAt; i < argc; i++) {
 		bool        atEnd = i == argc - 1;
-		std::string arg   = argv[i];
-		if (arg.length() != 0 && (arg[0] == '-' || arg == "/?")) {
+		const char* arg   = argv[i];
+		ARGPARSE_STAT(Stats.Tokens++);
+		if (arg[0] != 0 && (arg[0] == '-' || strcmp(arg, "/?") == 0)) {
 			// option
-			auto opt = cmd ? cmd->FindOption(arg.c_str()) : FindOption(arg.c_str());
-			if (opt) {
-				if (opt->ExpectsValue && atEnd) {
-					printf("\033[1;31mOption %s expects a value, eg \033[0;32m--%s <something>\033[0m\n", arg.c_str(), opt->Long.c_str());
-					return false;
+			Args*       scope     = cmd ? cmd : this;
+			const char* inlineVal = nullptr;
+			size_t      oi        = scope->FindOptionIndex(arg);
+			if (oi == (size_t) -1 && arg[1] == '-') {
+				// --opt=value. The value is the tail of the argv token, so it is NUL
+				// terminated and needs no copy; zero-copy mode points straight into it.
+				const char* eq = strchr(arg + 2, '=');
+				if (eq) {
+					oi = scope->FindLongIndex(arg + 2, (size_t) (eq - arg - 2));
+					if (oi != (size_t) -1)
+						inlineVal = eq + 1;
 				}
-				if (opt->ExpectsValue) {
+			}
+			if (oi != (size_t) -1) {
+				ARGPARSE_STAT(Stats.OptionHits++);
+				const Option& opt = scope->Options[oi];
+				if (inlineVal && !opt.ExpectsValue)
+					return Fail(ErrorCode::SwitchHasValue, i, oi, arg, scope);
+				if (opt.ExpectsValue && !inlineVal && atEnd)
+					return Fail(ErrorCode::MissingValue, i, oi, arg, scope);
+				if (inlineVal) {
+					ARGPARSE_STAT(Stats.ValueBytes += strlen(inlineVal));
+					if (!sink.OnOption(scope, oi, inlineVal))
+						return false;
+				} else if (opt.ExpectsValue) {
 					i++;
-					opt->Value   = argv[i];
-					opt->Toggled = true;
+					ARGPARSE_STAT(Stats.Tokens++);
+					ARGPARSE_STAT(Stats.ValueBytes += strlen(argv[i]));
+					if (!sink.OnOption(scope, oi, argv[i]))
+						return false;
 				} else {
-					opt->Toggled = true;
+					if (!sink.OnOption(scope, oi, nullptr))
+						return false;
 				}
 				continue;
-			} else {
+			}
+			// -abc: bundled short options. Valid only if every letter is a registered
+			// short name, and only the last may expect a value (taken from the next
+			// argv slot, as usual). Anything else falls through to the help keywords
+			// and the unknown-option error below.
+			if (arg[0] == '-' && arg[1] != '-' && arg[1] != 0 && arg[2] != 0) {
+				bool bundle = true;
+				for (const char* c = arg + 1; *c && bundle; c++) {
+					size_t bi = scope->FindShortIndex(*c);
+					bundle    = bi != (size_t) -1 && (!scope->Options[bi].ExpectsValue || c[1] == 0);
+				}
+				if (bundle) {
+					for (const char* c = arg + 1; *c; c++) {
+						size_t bi = scope->FindShortIndex(*c);
+						ARGPARSE_STAT(Stats.OptionHits++);
+						if (scope->Options[bi].ExpectsValue) {
+							if (atEnd)
+								return Fail(ErrorCode::MissingValue, i, bi, arg, scope);
+							i++;
+							ARGPARSE_STAT(Stats.Tokens++);
+							ARGPARSE_STAT(Stats.ValueBytes += strlen(argv[i]));
+							if (!sink.OnOption(scope, bi, argv[i]))
+								return false;
+						} else {
+							if (!sink.OnOption(scope, bi, nullptr))
+								return false;
+						}
+					}
+					continue;
+				}
+			}
+			{
+				ARGPARSE_STAT(Stats.OptionMisses++);
 				auto a = arg;
-				if (a == "-h" || a == "-help" || a == "--help" || a == "-?" || a == "/?" || a == "/h" || a == "/help") {
+				if (strcmp(a, "-h") == 0 || strcmp(a, "-help") == 0 || strcmp(a, "--help") == 0 || strcmp(a, "-?") == 0 || strcmp(a, "/?") == 0 || strcmp(a, "/h") == 0 || strcmp(a, "/help") == 0) {
 					if (atEnd && cmd)
 						ShowHelpInternal(0, cmd->CmdName);
 					else if (atEnd)
 						ShowHelp();
 					else
 						ShowHelpInternal(0, argv[i + 1]);
+					LastError.Code = ErrorCode::HelpShown;
 					return false;
 				}
-				if (IsNumeric(arg.c_str())) {
+				if (IsNumericToken(arg)) {
 					// If this is a negative number, then fall through to positional parameter
 				} else {
-					printf("\033[1;31mUnknown option '%s'\033[0m\n", arg.c_str());
-					return false;
+					return Fail(ErrorCode::UnknownOption, i, (size_t) -1, arg, scope);
 				}
 			}
 		}
 		if (Commands.size() != 0 && !cmd) {
 			// command
-			for (Args* c : Commands) {
-				if (c->CmdName == arg) {
-					cmd               = c;
-					cmd->CmdWasChosen = true;
-					break;
-				}
+			Args* c = FindCommand(arg);
+			if (c) {
+				cmd = c;
+				if (!c->EnsureSetup())
+					return false;
+				if (!sink.OnCommand(this, c))
+					return false;
 			}
 			if (!cmd) {
-				if (arg == "help" && !atEnd)
-					ShowHelpInternal(0, argv[i + 1]);
-				else if (arg == "help")
-					ShowHelpInternal(0, "");
-				else
-					printf("\033[1;31mUnknown command '%s'\033[0m\n", arg.c_str());
+				if (strcmp(arg, "help") == 0) {
+					ShowHelpInternal(0, atEnd ? "" : argv[i + 1]);
+					LastError.Code = ErrorCode::HelpShown;
+				} else {
+					Fail(ErrorCode::UnknownCommand, i, (size_t) -1, arg, this);
+				}
 				return false;
 			}
 			continue;
 		}
 
 		// positional parameter
-		if (cmd)
-			cmd->Params.push_back(arg);
-		else
-			Params.push_back(arg);
+		ARGPARSE_STAT(Stats.Params++);
+		ARGPARSE_STAT(Stats.ParamBytes += strlen(arg));
+		Args* pscope = cmd ? cmd : this;
+		if (!sink.OnParam(pscope, arg)) {
+			LastError.Code = ErrorCode::Aborted;
+			return false;
+		}
+		// Opt-in parallel path for huge runs (ParallelParamThreads): measure the run
+		// first with the same classifier as the tight loop below, then hand the whole
+		// span to the sink, which fills it on worker threads in order.
+		if (ParallelParamThreads > 1 && (size_t) (argc - (i + 1)) >= ParallelMinRun) {
+			int runEnd = i + 1;
+			while (runEnd < argc && argv[runEnd][0] != '-' && argv[runEnd][0] != 0 && strcmp(argv[runEnd], "/?") != 0)
+				runEnd++;
+			size_t run = (size_t) (runEnd - (i + 1));
+			if (run >= ParallelMinRun) {
+				if (!sink.OnParamRun(pscope, argv + i + 1, run, ParallelParamThreads)) {
+					LastError.Code = ErrorCode::Aborted;
+					return false;
+				}
+				ARGPARSE_STAT(for (int k = i + 1; k < runEnd; k++) { Stats.Tokens++; Stats.Params++; Stats.ParamBytes += strlen(argv[k]); });
+				i = runEnd - 1;
+				continue;
+			}
+		}
+		// A run of positionals (the common shape of response-file input) needs none
+		// of the option/command/help checks above, so consume it in a tight loop.
+		// Reaching this point means commands are settled: any later non-dash,
+		// non-empty token (other than "/?") is also a positional.
+		while (i + 1 < argc && argv[i + 1][0] != '-' && argv[i + 1][0] != 0 && strcmp(argv[i + 1], "/?") != 0) {
+			i++;
+			ARGPARSE_STAT(Stats.Tokens++);
+			ARGPARSE_STAT(Stats.Params++);
+			ARGPARSE_STAT(Stats.ParamBytes += strlen(argv[i]));
+			if (!sink.OnParam(pscope, argv[i])) {
+				LastError.Code = ErrorCode::Aborted;
+				return false;
+			}
+		}
 	}
 
 	if (cmd && cmd->CmdEnforceParams) {
-		auto nparams = cmd->Params.size();
-		if (nparams != cmd->CmdParamsCount()) {
-			printf("\033[1;31m%s expects %d parameters: %s, but there are %d parameters\033[0m\n", cmd->CmdName.c_str(), (int) cmd->CmdParamsCount(), cmd->CmdParams.c_str(), (int) nparams);
+		auto nparams = sink.ParamCount(cmd);
+		if (nparams != cmd->CmdParamsCount())
+			return Fail(ErrorCode::ParamCount, -1, (size_t) -1, nullptr, cmd, (int) nparams);
+	}
+
+	return sink.Finish(this, cmd);
+}
+
+inline void Args::TokenizeBuffer(char* data, size_t size, std::vector<const char*>& tokens) {
+	// The scans are SIMD on SSE2 targets (16 bytes per step), which is what makes
+	// multi-megabyte response files cheap to expand
+	size_t i = 0;
+	while (i < size) {
+		i = ScanWhitespace(data, size, i);
+		if (i >= size)
+			break;
+		tokens.push_back(data + i);
+		i = ScanToken(data, size, i);
+		// Terminate the token in place. When i == size, data[i] is the zero-filled
+		// byte beyond the end of the mapping (MappedFile guarantees it is readable).
+		if (i < size)
+			data[i++] = 0;
+	}
+}
+
+inline bool Args::ExpandArgv(int& argc, const char**& argv) {
+	bool any = false;
+	for (int i = 0; i < argc && !any; i++)
+		any = argv[i][0] == '@';
+	if (!any)
+		return true;
+	RespFiles.clear();
+	RespArgv.clear();
+	for (int i = 0; i < argc; i++) {
+		if (argv[i][0] != '@') {
+			RespArgv.push_back(argv[i]);
+			continue;
+		}
+		RespFiles.push_back(MappedFile());
+		MappedFile& mf = RespFiles.back();
+		if (!mf.Open(argv[i] + 1)) {
+			Fail(ErrorCode::BadResponseFile, i, (size_t) -1, argv[i] + 1, this);
+			return false;
+		}
+		TokenizeBuffer(mf.Data, mf.Size, RespArgv);
+	}
+	argc = (int) RespArgv.size();
+	argv = RespArgv.data();
+	return true;
+}
+
+inline bool Args::Parse(int argc, const char** argv, int startAt) {
+	LastError = ParseError();
+	if (!SanityCached) {
+		if (!ValidateSanity(0)) {
+			LastError.Code = ErrorCode::BadDefinition;
+			return false;
+		}
+		SanityCached = true;
+	}
+	if (ExpandResponseFiles && !ExpandArgv(argc, argv))
+		return false;
+	Reset();
+	ARGPARSE_STAT(Stats = ArgStats());
+	ARGPARSE_STAT(auto statsStart = std::chrono::high_resolution_clock::now());
+	MutatingSink sink;
+	bool ok = ParseCore(argc, argv, startAt, sink);
+	ARGPARSE_STAT(Stats.ParseSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - statsStart).count());
+	return ok;
+}
+
+#ifdef _WIN32
+inline bool Args::Parse(int argc, const wchar_t** argv, int startAt) {
+	WideArgvBuf.clear();
+	WideArgv.clear();
+	// Measuring scan: total UTF-8 bytes for all arguments, including NULs
+	size_t total = 0;
+	for (int i = 0; i < argc; i++) {
+		int n = WideCharToMultiByte(CP_UTF8, 0, argv[i], -1, nullptr, 0, nullptr, nullptr);
+		total += n > 0 ? (size_t) n : 1;
+	}
+	WideArgvBuf.resize(total);
+	WideArgv.reserve((size_t) argc);
+	// Conversion scan: each argument lands back to back in the one buffer
+	char*  p    = WideArgvBuf.data();
+	size_t left = total;
+	for (int i = 0; i < argc; i++) {
+		int n = WideCharToMultiByte(CP_UTF8, 0, argv[i], -1, p, (int) left, nullptr, nullptr);
+		if (n <= 0) {
+			// Unconvertible argument (CP_UTF8 substitutes rather than fails, so this
+			// should not happen in practice). Record it as an empty token.
+			*p = 0;
+			n  = 1;
+		}
+		WideArgv.push_back(p);
+		p += n;
+		left -= (size_t) n;
+	}
+	return Parse(argc, WideArgv.data(), startAt);
+}
+#endif
+
+inline bool Args::ParseTo(int argc, const char** argv, ParseResult& res, int startAt) {
+	LastError = ParseError();
+	if (!SanityCached) {
+		if (!ValidateSanity(0)) {
+			LastError.Code = ErrorCode::BadDefinition;
+			return false;
+		}
+		SanityCached = true;
+	}
+	if (ExpandResponseFiles && !ExpandArgv(argc, argv))
+		return false;
+	if (NameIndexDirty)
+		BuildNameIndex();
+	res          = ParseResult();
+	res.Root.Def = this;
+	res.Root.Opts.assign(Options.size(), ParseResult::OptionValue());
+	ARGPARSE_STAT(Stats = ArgStats());
+	ARGPARSE_STAT(auto statsStart = std::chrono::high_resolution_clock::now());
+	ResultSink sink;
+	sink.Res = &res;
+	bool ok = ParseCore(argc, argv, startAt, sink);
+	ARGPARSE_STAT(Stats.ParseSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - statsStart).count());
+	return ok;
+}
+
+inline bool Args::ParseStream(int argc, const char** argv, std::function<bool(const char* param)> onParam, int startAt) {
+	LastError = ParseError();
+	if (!SanityCached) {
+		if (!ValidateSanity(0)) {
+			LastError.Code = ErrorCode::BadDefinition;
 			return false;
 		}
+		SanityCached = true;
+	}
+	if (ExpandResponseFiles && !ExpandArgv(argc, argv))
+		return false;
+	Reset();
+	ARGPARSE_STAT(Stats = ArgStats());
+	ARGPARSE_STAT(auto statsStart = std::chrono::high_resolution_clock::now());
+	StreamSink sink;
+	sink.OnParamFn = &onParam;
+	bool ok = ParseCore(argc, argv, startAt, sink);
+	ARGPARSE_STAT(Stats.ParseSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - statsStart).count());
+	return ok;
+}
+
+inline void Args::ApplyOverlays() {
+	// One sweep over the options that declared an env var or config key. argv wins,
+	// then the environment, then the config lookup; whatever wins lands in Value
+	// before ConvertTypedValues runs, so typed validation covers every source.
+	for (size_t oi : OverlayOptions) {
+		auto& opt = Options[oi];
+		if (opt.Toggled) // argv supplied the value
+			continue;
+		const char* env = opt.EnvVar.empty() ? nullptr : getenv(opt.EnvVar.c_str());
+		std::string cfg;
+		if (env) {
+			opt.Value  = env;
+			opt.Source = ValueSource::Env;
+		} else if (!opt.ConfigKey.empty() && ConfigLookup && ConfigLookup(opt.ConfigKey, cfg)) {
+			opt.Value  = cfg;
+			opt.Source = ValueSource::Config;
+		} else {
+			continue;
+		}
+		opt.Toggled = true;
+		Touched.push_back(oi);
+#if ARGPARSE_HAS_STRING_VIEW
+		// Zero-copy readers view the owned Value, which is stable until the next parse
+		opt.ValueView = opt.Value;
+#endif
 	}
+}
 
+inline bool Args::ConvertTypedValues() {
+	// Untoggled options keep the caches computed at registration time (ie their
+	// defaults, restored by Reset), so only the options this parse toggled need
+	// converting
+	for (size_t oi : Touched) {
+		auto& opt = Options[oi];
+		if (!opt.ExpectsValue) {
+			// Keep GetInt/GetDouble on a switch behaving like Get: 1 when toggled, 0 otherwise
+			opt.CachedInt    = 1;
+			opt.CachedDouble = 1;
+			continue;
+		}
+		if (opt.Accumulate) {
+			// Accumulated values have no scalar cache; they are read via GetAll()
+			continue;
+		}
+#if ARGPARSE_HAS_STRING_VIEW
+		// In zero-copy mode ValueView points into an argv token, so it is NUL terminated
+		const char* s = ZeroCopy ? opt.ValueView.data() : opt.Value.c_str();
+#else
+		const char* s = opt.Value.c_str();
+#endif
+		bool ok = ConvertNumeric(s, opt.CachedInt, opt.CachedDouble);
+		if (!ok && opt.Type != ValueType::String)
+			return Fail(ErrorCode::BadValue, -1, oi, s, this);
+	}
 	return true;
 }
 
+inline bool Args::ConvertNumeric(const char* s, int64_t& intVal, double& dblVal) {
+	char* end   = nullptr;
+	intVal      = (int64_t) strtoll(s, &end, 10);
+	bool intOK  = end != s && *end == 0;
+	end         = nullptr;
+	dblVal      = strtod(s, &end);
+	bool dblOK  = end != s && *end == 0;
+	if (!intOK && dblOK)
+		intVal = (int64_t) dblVal;
+	return intOK || dblOK;
+}
+
 inline int Args::ExecCommand() {
 	auto cmd = WhichCommand();
 	if (!cmd)
@@ -306,77 +1947,447 @@ inline int Args::ExecCommand() {
 }
 
 inline Args* Args::WhichCommand() {
-	for (Args* c : Commands) {
-		if (c->CmdWasChosen)
-			return c;
-	}
+	return ChosenCmd;
+}
+
+inline void Args::BuildCmdIndex() const {
+	CmdIndex.clear();
+	CmdIndex.reserve(Commands.size());
+	for (Args* c : Commands)
+		CmdIndex.push_back({c->CmdName, c});
+	std::sort(CmdIndex.begin(), CmdIndex.end());
+	CmdIndexDirty = false;
+}
+
+inline Args* Args::FindCommand(const char* name) const {
+	if (CmdIndexDirty)
+		BuildCmdIndex();
+	auto it = std::lower_bound(CmdIndex.begin(), CmdIndex.end(), name,
+	                           [](const std::pair<std::string, Args*>& a, const char* b) { return strcmp(a.first.c_str(), b) < 0; });
+	if (it != CmdIndex.end() && it->first == name)
+		return it->second;
 	return nullptr;
 }
 
-inline bool Args::Has(const std::string& _short_or_long) const {
-	for (const auto& opt : Options) {
-		if ((opt.HasShort() && opt.Short == _short_or_long) || opt.Long == _short_or_long)
-			return opt.Toggled;
+inline std::vector<Args*> Args::FindCommandsByPrefix(const std::string& prefix) const {
+	if (CmdIndexDirty)
+		BuildCmdIndex();
+	std::vector<Args*> res;
+	auto               it = std::lower_bound(CmdIndex.begin(), CmdIndex.end(), prefix.c_str(),
+	                                         [](const std::pair<std::string, Args*>& a, const char* b) { return strcmp(a.first.c_str(), b) < 0; });
+	for (; it != CmdIndex.end() && it->first.compare(0, prefix.size(), prefix) == 0; it++)
+		res.push_back(it->second);
+	return res;
+}
+
+inline std::vector<std::string> Args::Complete(const std::string& prefix) const {
+	std::vector<std::string> res;
+	if (!prefix.empty() && prefix[0] == '-') {
+		size_t      dashes = prefix.find_first_not_of('-');
+		std::string stem   = dashes == std::string::npos ? "" : prefix.substr(dashes);
+		if (OptNamesDirty) {
+			OptNamesSorted.clear();
+			for (const auto& opt : Options)
+				OptNamesSorted.push_back(opt.Long);
+			std::sort(OptNamesSorted.begin(), OptNamesSorted.end());
+			OptNamesDirty = false;
+		}
+		auto it = std::lower_bound(OptNamesSorted.begin(), OptNamesSorted.end(), stem);
+		for (; it != OptNamesSorted.end() && it->compare(0, stem.size(), stem) == 0; it++)
+			res.push_back("--" + *it);
+		return res;
+	}
+	for (auto c : FindCommandsByPrefix(prefix))
+		res.push_back(c->CmdName);
+	return res;
+}
+
+inline bool Args::TryComplete(int argc, const char** argv, int startAt) {
+	if (startAt >= argc || strcmp(argv[startAt], "--complete") != 0)
+		return false;
+	// The words typed so far follow; the last is the prefix under the cursor. A
+	// preceding word that names a command moves the query into that command's scope.
+	Args*       scope = this;
+	std::string prefix;
+	if (startAt + 1 < argc)
+		prefix = argv[argc - 1];
+	for (int i = startAt + 1; i < argc - 1; i++) {
+		Args* c = FindCommand(argv[i]);
+		if (c && c->EnsureSetup())
+			scope = c;
 	}
-	printf("Option %s does not exist\n", _short_or_long.c_str());
+	std::string buf;
+	for (const auto& cand : scope->Complete(prefix))
+		AppendFmt(buf, "%s\n", cand.c_str());
+	Emit(buf);
+	return true;
+}
+
+inline std::string Args::BashCompletionScript(const std::string& progName) const {
+	std::string buf;
+	AppendFmt(buf,
+	          "_%s_complete() {\n"
+	          "\tlocal IFS=$'\\n'\n"
+	          "\tCOMPREPLY=($(\"%s\" --complete \"${COMP_WORDS[@]:1:COMP_CWORD}\" 2>/dev/null))\n"
+	          "}\n"
+	          "complete -o default -F _%s_complete %s\n",
+	          progName.c_str(), progName.c_str(), progName.c_str(), progName.c_str());
+	return buf;
+}
+
+inline std::string Args::ZshCompletionScript(const std::string& progName) const {
+	std::string buf;
+	AppendFmt(buf,
+	          "#compdef %s\n"
+	          "_%s() {\n"
+	          "\tlocal -a completions\n"
+	          "\tcompletions=(${(f)\"$(\"%s\" --complete ${words[2,CURRENT]} 2>/dev/null)\"})\n"
+	          "\t_describe 'values' completions\n"
+	          "}\n"
+	          "_%s \"$@\"\n",
+	          progName.c_str(), progName.c_str(), progName.c_str(), progName.c_str());
+	return buf;
+}
+
+inline bool Args::Has(const std::string& _short_or_long) const {
+	auto opt = FindByName(_short_or_long);
+	if (opt)
+		return opt->Toggled;
+	Errorf("Option %s does not exist\n", _short_or_long.c_str());
 	return false;
 }
 
 inline std::string Args::Get(const std::string& _short_or_long) const {
-	for (auto& opt : Options) {
-		if ((opt.HasShort() && opt.Short == _short_or_long) || opt.Long == _short_or_long) {
-			if (!opt.ExpectsValue) {
-				printf("Cannot use Get() on a Switch parameter. Use Has() instead.\n");
-				return opt.Toggled ? "1" : "0";
-			}
-			if (opt.Toggled)
-				return opt.Value;
-			else
-				return opt.Default;
+	auto opt = FindByName(_short_or_long);
+	if (opt) {
+		if (!opt->ExpectsValue) {
+			Errorf("Cannot use Get() on a Switch parameter. Use Has() instead.\n");
+			return opt->Toggled ? "1" : "0";
 		}
+#if ARGPARSE_HAS_STRING_VIEW
+		if (opt->Toggled && ZeroCopy)
+			return std::string(opt->ValueView);
+#endif
+		if (opt->Toggled)
+			return opt->Value;
+		else
+			return opt->Default;
 	}
 	return "";
 }
 
+inline const std::vector<std::string>& Args::GetAll(const std::string& _short_or_long) const {
+	static const std::vector<std::string> empty;
+	auto                                  opt = FindByName(_short_or_long);
+	return opt ? opt->Values : empty;
+}
+
+inline ValueSource Args::GetSource(const std::string& _short_or_long) const {
+	auto opt = FindByName(_short_or_long);
+	return opt ? opt->Source : ValueSource::Default;
+}
+
+#if ARGPARSE_HAS_STRING_VIEW
+inline const std::vector<std::string_view>& Args::GetAllViews(const std::string& _short_or_long) const {
+	static const std::vector<std::string_view> empty;
+	auto                                       opt = FindByName(_short_or_long);
+	return opt ? opt->ValueViews : empty;
+}
+
+inline std::string_view Args::GetView(const std::string& _short_or_long) const {
+	auto opt = FindByName(_short_or_long);
+	if (opt) {
+		if (!opt->ExpectsValue) {
+			Errorf("Cannot use GetView() on a Switch parameter. Use Has() instead.\n");
+			return opt->Toggled ? "1" : "0";
+		}
+		if (!opt->Toggled)
+			return std::string_view(opt->Default);
+		if (ZeroCopy)
+			return opt->ValueView;
+		return std::string_view(opt->Value);
+	}
+	return std::string_view();
+}
+#endif
+
+inline bool ParseResult::Scope::Has(const std::string& _short_or_long) const {
+	size_t i = Def ? Def->FindIndexByName(_short_or_long) : (size_t) -1;
+	if (i == (size_t) -1) {
+		if (Def)
+			Def->Errorf("Option %s does not exist\n", _short_or_long.c_str());
+		return false;
+	}
+	return Opts[i].Toggled;
+}
+
+inline const std::string& ParseResult::Scope::Get(const std::string& _short_or_long) const {
+	static const std::string empty;
+	size_t                   i = Def ? Def->FindIndexByName(_short_or_long) : (size_t) -1;
+	if (i == (size_t) -1)
+		return empty;
+	const Option& def = Def->Options[i];
+	if (!def.ExpectsValue) {
+		Def->Errorf("Cannot use Get() on a Switch parameter. Use Has() instead.\n");
+		return empty;
+	}
+	return Opts[i].Toggled ? Opts[i].Value : def.Default;
+}
+
+inline int ParseResult::Scope::GetInt(const std::string& _short_or_long) const {
+	return (int) GetInt64(_short_or_long);
+}
+
+inline int64_t ParseResult::Scope::GetInt64(const std::string& _short_or_long) const {
+	size_t i = Def ? Def->FindIndexByName(_short_or_long) : (size_t) -1;
+	return i == (size_t) -1 ? 0 : Opts[i].CachedInt;
+}
+
+inline double ParseResult::Scope::GetDouble(const std::string& _short_or_long) const {
+	size_t i = Def ? Def->FindIndexByName(_short_or_long) : (size_t) -1;
+	return i == (size_t) -1 ? 0 : Opts[i].CachedDouble;
+}
+
+inline const std::vector<std::string>& ParseResult::Scope::GetAll(const std::string& _short_or_long) const {
+	static const std::vector<std::string> empty;
+	size_t                                i = Def ? Def->FindIndexByName(_short_or_long) : (size_t) -1;
+	return i == (size_t) -1 ? empty : Opts[i].Values;
+}
+
+inline ValueSource ParseResult::Scope::GetSource(const std::string& _short_or_long) const {
+	size_t i = Def ? Def->FindIndexByName(_short_or_long) : (size_t) -1;
+	return i == (size_t) -1 ? ValueSource::Default : Opts[i].Source;
+}
+
+inline OptionHandle Args::Handle(const std::string& _short_or_long) const {
+	OptionHandle h;
+	h.Index = FindIndexByName(_short_or_long);
+	if (!h.Valid())
+		Errorf("Option %s does not exist\n", _short_or_long.c_str());
+	return h;
+}
+
+inline bool Args::Has(OptionHandle h) const {
+	return h.Valid() ? Options[h.Index].Toggled : false;
+}
+
+inline const std::string& Args::Get(OptionHandle h) const {
+	static const std::string empty;
+	if (!h.Valid())
+		return empty;
+	const Option& opt = Options[h.Index];
+#if ARGPARSE_HAS_STRING_VIEW
+	if (opt.Toggled && ZeroCopy) {
+		// The value lives in ValueView and opt.Value is empty, so returning it here
+		// would be silently wrong
+		Errorf("Get(handle) cannot return a value in zero-copy mode. Use GetView(handle) instead.\n");
+		return empty;
+	}
+#endif
+	return opt.Toggled ? opt.Value : opt.Default;
+}
+
+inline int Args::GetInt(OptionHandle h) const {
+	return h.Valid() ? (int) Options[h.Index].CachedInt : 0;
+}
+
+inline int64_t Args::GetInt64(OptionHandle h) const {
+	return h.Valid() ? Options[h.Index].CachedInt : 0;
+}
+
+inline double Args::GetDouble(OptionHandle h) const {
+	return h.Valid() ? Options[h.Index].CachedDouble : 0;
+}
+
+inline const std::vector<std::string>& Args::GetAll(OptionHandle h) const {
+	static const std::vector<std::string> empty;
+#if ARGPARSE_HAS_STRING_VIEW
+	if (h.Valid() && ZeroCopy && !Options[h.Index].ValueViews.empty()) {
+		Errorf("GetAll(handle) cannot return values in zero-copy mode. Use GetAllViews(handle) instead.\n");
+		return empty;
+	}
+#endif
+	return h.Valid() ? Options[h.Index].Values : empty;
+}
+
+#if ARGPARSE_HAS_STRING_VIEW
+inline std::string_view Args::GetView(OptionHandle h) const {
+	if (!h.Valid())
+		return std::string_view();
+	const Option& opt = Options[h.Index];
+	if (!opt.Toggled)
+		return std::string_view(opt.Default);
+	if (ZeroCopy)
+		return opt.ValueView;
+	return std::string_view(opt.Value);
+}
+
+inline const std::vector<std::string_view>& Args::GetAllViews(OptionHandle h) const {
+	static const std::vector<std::string_view> empty;
+	return h.Valid() ? Options[h.Index].ValueViews : empty;
+}
+#endif
+
 inline int Args::GetInt(const std::string& _short_or_long) const {
-	return atoi(Get(_short_or_long).c_str());
+	auto opt = FindByName(_short_or_long);
+	return opt ? (int) opt->CachedInt : 0;
 }
 
 inline int64_t Args::GetInt64(const std::string& _short_or_long) const {
-#ifdef _MSC_VER
-	return (int64_t) _atoi64(Get(_short_or_long).c_str());
-#else
-	return (int64_t) atoll(Get(_short_or_long).c_str());
-#endif
+	auto opt = FindByName(_short_or_long);
+	return opt ? opt->CachedInt : 0;
 }
 
 inline double Args::GetDouble(const std::string& _short_or_long) const {
-	return atof(Get(_short_or_long).c_str());
+	auto opt = FindByName(_short_or_long);
+	return opt ? opt->CachedDouble : 0;
 }
 
-inline Option* Args::FindOption(const char* arg) {
-	for (auto& opt : Options) {
-		if (opt.HasShort() && strcmp(opt.Short.c_str(), arg + 1) == 0)
-			return &opt;
-		if (arg[1] == '-' && strcmp(opt.Long.c_str(), arg + 2) == 0)
-			return &opt;
+inline void Args::BuildNameIndex() const {
+	size_t numNames = 0;
+	for (size_t i = 0; i < Options.size(); i++)
+		numNames += Options[i].HasShort() ? 2 : 1;
+	// Cap the load factor at 50%, so probe chains stay a handful of adjacent slots
+	size_t cap = 8;
+	while (cap < numNames * 2)
+		cap <<= 1;
+	NameSlots.assign(cap, NameSlot());
+	NamePool.clear();
+	auto intern = [&](const std::string& name, uint32_t packedIdx) {
+		uint32_t h    = HashName(name.data(), name.size());
+		size_t   slot = h & (cap - 1);
+		while (NameSlots[slot].NameLen != 0)
+			slot = (slot + 1) & (cap - 1);
+		NameSlots[slot].NameOff = (uint32_t) NamePool.size();
+		NameSlots[slot].NameLen = (uint32_t) name.size();
+		NameSlots[slot].OptIdx  = packedIdx;
+		NameSlots[slot].Hash    = h;
+		NamePool.insert(NamePool.end(), name.begin(), name.end());
+	};
+	for (size_t i = 0; i < Options.size(); i++) {
+		if (Options[i].HasShort())
+			intern(Options[i].Short, (uint32_t) i);
+		intern(Options[i].Long, (uint32_t) i | NameIsLong);
 	}
-	return nullptr;
+	NameIndexDirty = false;
+}
+
+inline uint32_t Args::ProbeName(const char* name, size_t len) const {
+	if (NameIndexDirty)
+		BuildNameIndex();
+	uint32_t h    = HashName(name, len);
+	size_t   mask = NameSlots.size() - 1;
+	for (size_t slot = h & mask; NameSlots[slot].NameLen != 0; slot = (slot + 1) & mask) {
+		const NameSlot& s = NameSlots[slot];
+		if (s.Hash == h && s.NameLen == (uint32_t) len && memcmp(NamePool.data() + s.NameOff, name, len) == 0)
+			return s.OptIdx;
+	}
+	return NameMiss;
+}
+
+inline size_t Args::FindIndexByName(const std::string& _short_or_long) const {
+	uint32_t r = ProbeName(_short_or_long.data(), _short_or_long.size());
+	return r == NameMiss ? (size_t) -1 : (size_t) (r & ~NameIsLong);
+}
+
+inline const Option* Args::FindByName(const std::string& _short_or_long) const {
+	size_t i = FindIndexByName(_short_or_long);
+	return i == (size_t) -1 ? nullptr : &Options[i];
+}
+
+inline size_t Args::FindOptionIndex(const char* arg) const {
+	// Long names may only be found via "--name", and short names via "-n". Since
+	// ValidateSanity guarantees that names are unique across both sets, a single
+	// probe finds the one possible entry, and NameIsLong says which form it was.
+	if (arg[1] == '-') {
+		uint32_t r = ProbeName(arg + 2, strlen(arg + 2));
+		if (r != NameMiss && (r & NameIsLong))
+			return r & ~NameIsLong;
+	} else {
+		uint32_t r = ProbeName(arg + 1, strlen(arg + 1));
+		if (r != NameMiss && !(r & NameIsLong))
+			return r & ~NameIsLong;
+	}
+	return (size_t) -1;
+}
+
+inline size_t Args::FindLongIndex(const char* name, size_t len) const {
+	uint32_t r = ProbeName(name, len);
+	if (r != NameMiss && (r & NameIsLong))
+		return r & ~NameIsLong;
+	return (size_t) -1;
+}
+
+inline size_t Args::FindShortIndex(char c) const {
+	uint32_t r = ProbeName(&c, 1);
+	if (r != NameMiss && !(r & NameIsLong))
+		return r & ~NameIsLong;
+	return (size_t) -1;
+}
+
+inline std::string Args::SuggestFrom(const std::vector<std::vector<std::string>>& buckets, const std::string& name) {
+	std::string best;
+	int         bestDist = 3; // suggest only within edit distance 2
+	size_t      lo       = name.size() > 2 ? name.size() - 2 : 0;
+	size_t      hi       = name.size() + 2;
+	for (size_t len = lo; len <= hi && len < buckets.size(); len++) {
+		for (const auto& cand : buckets[len]) {
+			int d = BoundedEditDistance(name, cand, bestDist - 1);
+			if (d < bestDist) {
+				bestDist = d;
+				best     = cand;
+				if (bestDist == 1)
+					return best;
+			}
+		}
+	}
+	return best;
+}
+
+inline std::string Args::SuggestOption(const std::string& name) const {
+	if (OptSuggestDirty) {
+		OptSuggestBuckets.clear();
+		for (const auto& opt : Options) {
+			if (opt.Long.size() >= OptSuggestBuckets.size())
+				OptSuggestBuckets.resize(opt.Long.size() + 1);
+			OptSuggestBuckets[opt.Long.size()].push_back(opt.Long);
+		}
+		OptSuggestDirty = false;
+	}
+	return SuggestFrom(OptSuggestBuckets, name);
+}
+
+inline std::string Args::SuggestCommand(const std::string& name) const {
+	if (CmdSuggestDirty) {
+		CmdSuggestBuckets.clear();
+		for (auto c : Commands) {
+			if (c->CmdName.size() >= CmdSuggestBuckets.size())
+				CmdSuggestBuckets.resize(c->CmdName.size() + 1);
+			CmdSuggestBuckets[c->CmdName.size()].push_back(c->CmdName);
+		}
+		CmdSuggestDirty = false;
+	}
+	return SuggestFrom(CmdSuggestBuckets, name);
+}
+
+inline Option* Args::FindOption(const char* arg) {
+	size_t i = FindOptionIndex(arg);
+	return i == (size_t) -1 ? nullptr : &Options[i];
 }
 
 inline bool Args::ValidateSanity(int depth) const {
 	std::unordered_set<std::string> seen;
 	for (const auto& opt : Options) {
 		if (opt.HasShort() && opt.Short.size() != 1) {
-			printf("Short options must be one character exactly (not %s)\n", opt.Short.c_str());
+			Errorf("Short options must be one character exactly (not %s)\n", opt.Short.c_str());
 			return false;
 		}
 		if (opt.HasShort() && seen.find(opt.Short) != seen.end()) {
-			printf("Option %s appears twice\n", opt.Short.c_str());
+			Errorf("Option %s appears twice\n", opt.Short.c_str());
 			return false;
 		}
 		if (seen.find(opt.Long) != seen.end()) {
-			printf("Option %s appears twice\n", opt.Long.c_str());
+			Errorf("Option %s appears twice\n", opt.Long.c_str());
 			return false;
 		}
 		if (opt.HasShort())
@@ -384,11 +2395,11 @@ inline bool Args::ValidateSanity(int depth) const {
 		seen.insert(opt.Long);
 	}
 	if (depth == 1 && Commands.size() != 0) {
-		printf("Commands cannot be nested. Command '%s' has commands beneath it.\n", CmdName.c_str());
+		Errorf("Commands cannot be nested. Command '%s' has commands beneath it.\n", CmdName.c_str());
 		return false;
 	}
 	if (Commands.size() != 0 && Params.size() != 0) {
-		printf("You cannot mix commands and parameters on the top-level object. Commands go on top, and parameters on the children.");
+		Errorf("You cannot mix commands and parameters on the top-level object. Commands go on top, and parameters on the children.");
 		return false;
 	}
 	for (auto c : Commands) {
@@ -399,74 +2410,111 @@ inline bool Args::ValidateSanity(int depth) const {
 }
 
 inline void Args::Reset() {
-	for (auto& opt : Options) {
-		opt.Toggled = false;
-		opt.Value   = "";
+	// Untouched options already hold their default state, so only the options the
+	// previous parse toggled need work. clear() (rather than assignment) keeps the
+	// capacity of every buffer, so steady-state re-parsing of similar command lines
+	// in a daemon does not allocate.
+	for (size_t oi : Touched) {
+		auto& opt        = Options[oi];
+		opt.Toggled      = false;
+		opt.Value.clear();
+		opt.CachedInt    = opt.DefaultInt;
+		opt.CachedDouble = opt.DefaultDouble;
+		opt.Source       = ValueSource::Default;
+		opt.Values.clear();
+#if ARGPARSE_HAS_STRING_VIEW
+		opt.ValueView = std::string_view();
+		opt.ValueViews.clear();
+#endif
 	}
-	for (auto c : Commands) {
-		c->CmdWasChosen = false;
-		c->Reset();
+	Touched.clear();
+	Params.clear();
+#if ARGPARSE_HAS_STRING_VIEW
+	ParamViews.clear();
+#endif
+	// Only the command chosen by the previous parse has state to reset, so a tree
+	// with hundreds of commands is not walked every parse
+	if (ChosenCmd) {
+		ChosenCmd->CmdWasChosen = false;
+		ChosenCmd->Reset();
 	}
+	ChosenCmd = nullptr;
 }
 
-inline void Args::WriteFormattedText(int indent, std::string text, int lineLength) {
+inline void Args::WriteFormattedText(int indent, std::string text, int lineLength, std::string& buf) {
 	std::string line;
 	for (size_t i = 0; i < text.size(); i++) {
-		bool tooLong            = line.length() > lineLength && line.back() == ' ';
+		bool tooLong            = line.length() > (size_t) lineLength && line.back() == ' ';
 		bool hasExplicitNewline = line.length() > 0 && line.back() == '\n';
 		if (tooLong || hasExplicitNewline) {
-			printf("%*s%s", indent, " ", line.c_str());
+			AppendFmt(buf, "%*s%s", indent, " ", line.c_str());
 			if (!hasExplicitNewline)
-				printf("\n");
+				buf += '\n';
 			line = "";
 		}
 		line += text[i];
 	}
 	if (line != "")
-		printf("%*s%s\n", indent, " ", line.c_str());
+		AppendFmt(buf, "%*s%s\n", indent, " ", line.c_str());
 }
 
-inline bool Args::IsNumeric(const char* s) {
-	for (; *s; s++) {
-		if (!((*s >= '0' && *s <= '9') || *s == '-' || *s == '+' || *s == '.' || *s == 'e'))
-			return false;
-	}
-	return true;
+inline void Args::ShowHelpInternal(int depth, std::string forCmd) {
+	std::string buf;
+	RenderHelp(depth, forCmd, buf);
+	Emit(buf);
 }
 
-inline void Args::ShowHelpInternal(int depth, std::string forCmd) {
-	const int maxLineLength = 80;
+inline void Args::InvalidateHelpCache() {
+	HelpCacheValid[0] = false;
+	HelpCacheValid[1] = false;
+}
+
+inline void Args::RenderHelp(int depth, const std::string& forCmd, std::string& buf) {
 	if (forCmd != "") {
 		for (auto c : Commands) {
 			if (c->CmdName == forCmd) {
-				c->ShowHelpInternal(1, "");
+				c->EnsureSetup();
+				c->RenderHelp(1, "", buf);
 				return;
 			}
 		}
-		printf("Unknown command '%s'\n", forCmd.c_str());
+		AppendFmt(buf, "Unknown command '%s'\n", forCmd.c_str());
 		return;
 	}
 
+	int slot = depth == 1 ? 1 : 0;
+	if (!HelpCacheValid[slot]) {
+		HelpCache[slot].clear();
+		RenderHelpUncached(depth, HelpCache[slot]);
+		HelpCacheValid[slot] = true;
+	}
+	buf += HelpCache[slot];
+	WasHelpShown = true;
+}
+
+inline void Args::RenderHelpUncached(int depth, std::string& buf) {
+	const int maxLineLength = 80;
+
 	int maxLong = 0;
 	for (const auto& opt : Options)
 		maxLong = (int) opt.Long.length() > maxLong ? (int) opt.Long.length() : maxLong;
 
 	if (depth == 1) {
 		if (CmdParams != "")
-			printf("%s %s\n\n %s\n", CmdName.c_str(), CmdParams.c_str(), UsageShort().c_str());
+			AppendFmt(buf, "%s %s\n\n %s\n", CmdName.c_str(), CmdParams.c_str(), UsageShort().c_str());
 		else
-			printf("%s %s\n\n", CmdName.c_str(), UsageShort().c_str());
+			AppendFmt(buf, "%s %s\n\n", CmdName.c_str(), UsageShort().c_str());
 		auto details = UsageDetails();
 		if (details != "") {
-			printf("\n");
-			WriteFormattedText(1, details, maxLineLength);
+			buf += '\n';
+			WriteFormattedText(1, details, maxLineLength, buf);
 		}
 	} else {
-		printf("%s\n", UsageShort().c_str());
+		AppendFmt(buf, "%s\n", UsageShort().c_str());
 		auto details = UsageDetails();
 		if (details != "") {
-			printf("\n");
-			WriteFormattedText(1, details, maxLineLength);
+			buf += '\n';
+			WriteFormattedText(1, details, maxLineLength, buf);
 		}
 
 		if (Commands.size() != 0) {
@@ -475,29 +2523,152 @@ inline void Args::ShowHelpInternal(int depth, std::string forCmd) {
 				maxCmd = (int) c->CmdName.length() > maxCmd ? (int) c->CmdName.length() : maxCmd;
 			}
 
-			printf("\n");
+			buf += '\n';
 			for (auto c : Commands) {
-				printf(" %-*s %s\n", maxCmd, c->CmdName.c_str(), c->UsageShort().c_str());
+				AppendFmt(buf, " %-*s %s\n", maxCmd, c->CmdName.c_str(), c->UsageShort().c_str());
 			}
 		}
 	}
-	printf("\n");
+	buf += '\n';
 
 	auto copy = Options;
 	std::sort(copy.begin(), copy.end());
 	for (const auto& opt : copy) {
 		if (opt.HasShort())
-			printf(" -%s --%-*s %s", opt.Short.c_str(), maxLong, opt.Long.c_str(), opt.Summary.c_str());
+			AppendFmt(buf, " -%s --%-*s %s", opt.Short.c_str(), maxLong, opt.Long.c_str(), opt.Summary.c_str());
 		else
-			printf("    --%-*s %s", maxLong, opt.Long.c_str(), opt.Summary.c_str());
+			AppendFmt(buf, "    --%-*s %s", maxLong, opt.Long.c_str(), opt.Summary.c_str());
 		if (opt.ExpectsValue && opt.Default != "") {
-			printf(" (%s)", opt.Default.c_str());
+			AppendFmt(buf, " (%s)", opt.Default.c_str());
 		}
-		printf("\n");
+		buf += '\n';
 	}
-	WasHelpShown = true;
 }
 
+// FixedArgs is a fixed-capacity variant of Args for allocation-sensitive code such
+// as embedded agents, where the cold-start path may not touch the heap. All storage
+// is inline and sized at compile time, and nothing in setup, Parse or the getters
+// allocates. Values and parameters are pointers into argv, so they are only valid
+// for as long as argv is. FixedArgs parses the same option grammar as Args, but has
+// no commands, no response files, and no help rendering.
+template <size_t MaxOpts, size_t MaxParams>
+class FixedArgs {
+public:
+	struct FixedOption {
+		const char* Short;        // Optional single-character short name ("" = none)
+		const char* Long;         // Mandatory long name
+		const char* Default;      // Default value, for options that expect one
+		const char* Value;        // Parsed value, pointing into argv (Default before Parse)
+		bool        ExpectsValue; // True if flag has an associated value
+		bool        Toggled;      // True if the option was specified
+	};
+
+	FixedOption Options[MaxOpts] = {};
+	const char* Params[MaxParams] = {};
+	size_t      NumOptions = 0;
+	size_t      NumParams  = 0;
+
+	// Add and AddSwitch/AddValue return false when the option table is full
+	bool AddSwitch(const char* _short, const char* _long) {
+		return Add(_short, _long, "0", false);
+	}
+	bool AddValue(const char* _short, const char* _long, const char* defaultValue = "") {
+		return Add(_short, _long, defaultValue, true);
+	}
+
+	bool Parse(int argc, const char** argv) {
+		Reset();
+		for (int i = 1; i < argc; i++) {
+			const char* arg = argv[i];
+			if (arg[0] == '-') {
+				FixedOption* opt = FindArg(arg);
+				if (opt) {
+					opt->Toggled = true;
+					if (opt->ExpectsValue) {
+						if (i == argc - 1) {
+							printf("\033[1;31mOption %s expects a value, eg \033[0;32m--%s <something>\033[0m\n", arg, opt->Long);
+							return false;
+						}
+						opt->Value = argv[++i];
+					}
+					continue;
+				}
+				if (!IsNumericToken(arg)) {
+					printf("\033[1;31mUnknown option '%s'\033[0m\n", arg);
+					return false;
+				}
+				// Negative number, so fall through to positional parameter
+			}
+			if (NumParams == MaxParams) {
+				printf("\033[1;31mToo many parameters (max %d)\033[0m\n", (int) MaxParams);
+				return false;
+			}
+			Params[NumParams++] = arg;
+		}
+		return true;
+	}
+
+	bool Has(const char* _short_or_long) const {
+		const FixedOption* opt = FindByName(_short_or_long);
+		return opt && opt->Toggled;
+	}
+	const char* Get(const char* _short_or_long) const {
+		const FixedOption* opt = FindByName(_short_or_long);
+		return opt ? opt->Value : "";
+	}
+	int64_t GetInt64(const char* _short_or_long) const {
+		return strtoll(Get(_short_or_long), nullptr, 10);
+	}
+	int GetInt(const char* _short_or_long) const {
+		return (int) GetInt64(_short_or_long);
+	}
+	double GetDouble(const char* _short_or_long) const {
+		return strtod(Get(_short_or_long), nullptr);
+	}
+
+private:
+	bool Add(const char* _short, const char* _long, const char* defaultValue, bool expectsValue) {
+		if (NumOptions == MaxOpts)
+			return false;
+		FixedOption& opt = Options[NumOptions++];
+		opt.Short        = _short;
+		opt.Long         = _long;
+		opt.Default      = defaultValue;
+		opt.Value        = defaultValue;
+		opt.ExpectsValue = expectsValue;
+		opt.Toggled      = false;
+		return true;
+	}
+
+	void Reset() {
+		for (size_t i = 0; i < NumOptions; i++) {
+			Options[i].Toggled = false;
+			Options[i].Value   = Options[i].Default;
+		}
+		NumParams = 0;
+	}
+
+	// Long names may only be found via "--name", and short names via "-n" (same rule
+	// as Args::FindOptionIndex)
+	FixedOption* FindArg(const char* arg) {
+		// An option with no short form stores Short = "", which must not match the
+		// empty remainder of a lone "-" token (the conventional stdin placeholder)
+		for (size_t i = 0; i < NumOptions; i++) {
+			if (arg[1] == '-' ? strcmp(Options[i].Long, arg + 2) == 0 : (Options[i].Short[0] != 0 && strcmp(Options[i].Short, arg + 1) == 0))
+				return &Options[i];
+		}
+		return nullptr;
+	}
+
+	const FixedOption* FindByName(const char* _short_or_long) const {
+		for (size_t i = 0; i < NumOptions; i++) {
+			if (strcmp(Options[i].Long, _short_or_long) == 0 || (Options[i].Short[0] != 0 && strcmp(Options[i].Short, _short_or_long) == 0))
+				return &Options[i];
+		}
+		return nullptr;
+	}
+};
+
 } // namespace argparse
 
 #endif
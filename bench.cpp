@@ -0,0 +1,207 @@
+// Microbenchmarks for argparse. Self-contained, no dependencies:
+//
+//	g++ -O2 -std=c++11 bench.cpp -o bench && ./bench
+//
+// Each scenario reports ns/op and allocs/op, where "op" is the unit named in the
+// scenario (one Parse call, one argv token, one GetInt call, ...). Allocations are
+// counted by a global operator new hook. The counters are relaxed atomics so that
+// the ParallelParamThreads scenarios count correctly too.
+
+#include "argparse.h"
+#include <atomic>
+#include <chrono>
+
+static std::atomic<size_t> g_allocCount(0);
+static std::atomic<size_t> g_allocBytes(0);
+
+void* operator new(size_t size) {
+	g_allocCount.fetch_add(1, std::memory_order_relaxed);
+	g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+	return malloc(size);
+}
+void operator delete(void* p) noexcept {
+	free(p);
+}
+void operator delete(void* p, size_t) noexcept {
+	free(p);
+}
+
+// Swallow all help/error output, so benchmarks measure work, not terminal speed
+static void NullSink(const char*, size_t) {
+}
+
+typedef std::chrono::high_resolution_clock Clock;
+
+// Run 'fn' until at least minSeconds have elapsed, then report time and allocations
+// divided by iters * opsPerIter.
+template <typename F>
+void Bench(const char* name, size_t opsPerIter, F fn) {
+	const double minSeconds = 0.2;
+	fn(); // warmup
+	size_t iters  = 0;
+	size_t allocs = g_allocCount;
+	auto   start  = Clock::now();
+	double elapsed;
+	do {
+		fn();
+		iters++;
+		elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+	} while (elapsed < minSeconds);
+	double ops = (double) iters * (double) opsPerIter;
+	printf("%-44s %12.1f ns/op %10.2f allocs/op\n", name, 1e9 * elapsed / ops, (double) (g_allocCount - allocs) / ops);
+}
+
+static void MakeOptions(argparse::Args& args, int n) {
+	char l[64];
+	for (int i = 0; i < n; i++) {
+		snprintf(l, sizeof(l), "option-%d", i);
+		args.AddValue("", l, "A generated option", "0");
+	}
+}
+
+static void BenchParseWithOptions(int numOpts) {
+	argparse::Args args("bench [options...]");
+	args.SetOutput(NullSink);
+	MakeOptions(args, numOpts);
+
+	const char* argv[6] = {"bench", "--option-0", "1", "--option-1", "2", "pos"};
+	char        name[64];
+	snprintf(name, sizeof(name), "Parse, %d registered options (per parse)", numOpts);
+	Bench(name, 1, [&args, &argv]() { args.Parse(6, argv); });
+}
+
+static void BenchParseTokens(size_t numTokens) {
+	argparse::Args args("bench [options...] files...");
+	args.SetOutput(NullSink);
+	args.AddSwitch("f", "force", "Force a thing");
+
+	std::vector<const char*> argv;
+	argv.push_back("bench");
+	for (size_t i = 0; i < numTokens; i++)
+		argv.push_back("some/positional/path.txt");
+
+	char name[64];
+	snprintf(name, sizeof(name), "Parse, %d positional tokens (per token)", (int) numTokens);
+	Bench(name, numTokens, [&args, &argv]() { args.Parse((int) argv.size(), argv.data()); });
+
+#if ARGPARSE_HAS_STRING_VIEW
+	args.ZeroCopy = true;
+	snprintf(name, sizeof(name), "  ... zero-copy mode (per token)");
+	Bench(name, numTokens, [&args, &argv]() { args.Parse((int) argv.size(), argv.data()); });
+	args.ZeroCopy = false;
+#endif
+
+#if ARGPARSE_HAS_STRING_VIEW
+	if (numTokens >= argparse::Args::ParallelMinRun) {
+		args.ParallelParamThreads = 4;
+		args.ZeroCopy             = true;
+		snprintf(name, sizeof(name), "  ... zero-copy, 4 threads (per token)");
+		Bench(name, numTokens, [&args, &argv]() { args.Parse((int) argv.size(), argv.data()); });
+		args.ZeroCopy             = false;
+		args.ParallelParamThreads = 0;
+	}
+#endif
+
+	snprintf(name, sizeof(name), "  ... ParseStream (per token)");
+	Bench(name, numTokens, [&args, &argv]() {
+		args.ParseStream((int) argv.size(), argv.data(), [](const char*) { return true; });
+	});
+}
+
+static void BenchResponseFile() {
+	const char* fname = "argparse_bench_resp.txt";
+	FILE*       f     = fopen(fname, "wb");
+	size_t      numTokens = 1000000;
+	for (size_t i = 0; i < numTokens; i++)
+		fprintf(f, "some/positional/path-%06d.txt\n", (int) i);
+	fclose(f);
+
+	argparse::Args args("bench [options...] files...");
+	args.SetOutput(NullSink);
+	args.AddSwitch("f", "force", "Force a thing");
+	args.ExpandResponseFiles = true;
+
+	const char* argv[2] = {"bench", "@argparse_bench_resp.txt"};
+	Bench("Parse @response-file, 1M tokens (per token)", numTokens, [&args, &argv]() {
+		args.ParseStream(2, argv, [](const char*) { return true; });
+	});
+	remove(fname);
+}
+
+static void BenchFindOption() {
+	argparse::Args args("bench [options...]");
+	args.SetOutput(NullSink);
+	MakeOptions(args, 2000);
+
+	const char* hit[2]  = {"bench", "--option-1999"};
+	const char* miss[2] = {"bench", "--no-such-option"};
+	Bench("FindOption hit, 2000 options (per parse)", 1, [&args, &hit]() { args.Parse(2, hit); });
+	Bench("FindOption miss, 2000 options (per parse)", 1, [&args, &miss]() { args.Parse(2, miss); });
+}
+
+static void BenchSchemaLoad() {
+	const char* fname = "argparse_bench_schema.bin";
+	{
+		argparse::Args args("bench [options...]");
+		MakeOptions(args, 2000);
+		args.SaveSchema(fname);
+	}
+
+	Bench("Build table, 2000 AddValue calls (per build)", 1, []() {
+		argparse::Args args("bench [options...]");
+		MakeOptions(args, 2000);
+	});
+	Bench("Build table, LoadSchema, 2000 options (per load)", 1, [fname]() {
+		argparse::Args args("");
+		args.LoadSchema(fname);
+	});
+	remove(fname);
+}
+
+static void BenchGetInt() {
+	argparse::Args args("bench [options...]");
+	args.SetOutput(NullSink);
+	args.AddValue("t", "timeout", "Timeout in seconds", "60");
+	const char* argv[3] = {"bench", "--timeout", "120"};
+	args.Parse(3, argv);
+
+	volatile int sum = 0;
+	Bench("GetInt by name (per call)", 1000, [&args, &sum]() {
+		for (int i = 0; i < 1000; i++)
+			sum += args.GetInt("timeout");
+	});
+
+	auto h = args.Handle("timeout");
+	Bench("GetInt by handle (per call)", 1000, [&args, &sum, h]() {
+		for (int i = 0; i < 1000; i++)
+			sum += args.GetInt(h);
+	});
+}
+
+static void BenchShowHelp() {
+	argparse::Args args("bench [options...]\nA longer description of this tool, which gets word wrapped by the help renderer.");
+	args.SetOutput(NullSink);
+	MakeOptions(args, 2000);
+
+	Bench("ShowHelp, 2000 options, cached (per call)", 1, [&args]() { args.ShowHelp(); });
+	Bench("ShowHelp, 2000 options, re-render (per call)", 1, [&args]() {
+		// Adding an option invalidates the cached help text
+		args.AddValue("", "invalidate-me", "Force a re-render", "0");
+		args.ShowHelp();
+	});
+}
+
+int main(int argc, char** argv) {
+	BenchParseWithOptions(10);
+	BenchParseWithOptions(100);
+	BenchParseWithOptions(2000);
+	BenchParseTokens(10);
+	BenchParseTokens(10000);
+	BenchParseTokens(1000000);
+	BenchResponseFile();
+	BenchFindOption();
+	BenchGetInt();
+	BenchSchemaLoad();
+	BenchShowHelp();
+	return 0;
+}
@@ -0,0 +1,284 @@
+// Fuzz and worst-case budget harness for argparse. Self-contained, no dependencies:
+//
+//	g++ -O2 -std=c++11 -pthread fuzz.cpp -o fuzz && ./fuzz
+//
+// The microbenchmarks in bench.cpp measure the average case; this harness feeds
+// deliberately pathological inputs (huge single tokens, storms of dash tokens,
+// giant help texts, degenerate response files) and fails with a nonzero exit code
+// if any input class exceeds its time or allocation budget, or if a path that
+// should be linear scales worse than linearly. The generator is a fixed-seed
+// xorshift PRNG, so every run sees the same inputs and failures reproduce.
+//
+// Time budgets are deliberately loose (several times the observed cost on a modest
+// machine), so they catch a path going quadratic or starting to allocate per byte,
+// not ordinary machine-to-machine variance.
+
+#include "argparse.h"
+#include <chrono>
+
+static size_t g_allocCount = 0;
+
+void* operator new(size_t size) {
+	g_allocCount++;
+	return malloc(size);
+}
+void operator delete(void* p) noexcept {
+	free(p);
+}
+void operator delete(void* p, size_t) noexcept {
+	free(p);
+}
+
+static void NullSink(const char*, size_t) {
+}
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static int g_failures = 0;
+
+// Deterministic PRNG, so failures reproduce across runs and machines
+struct Rng {
+	uint32_t State = 0x2545f491;
+	uint32_t Next() {
+		State ^= State << 13;
+		State ^= State >> 17;
+		State ^= State << 5;
+		return State;
+	}
+	uint32_t Next(uint32_t n) { return Next() % n; }
+};
+
+// Run 'fn' until at least 0.05 seconds have elapsed, then check time and
+// allocations per op against the class budget. "op" is the natural unit of the
+// input class (one byte, one token, one parse).
+template <typename F>
+void Budget(const char* name, size_t opsPerIter, double maxNsPerOp, double maxAllocsPerOp, F fn) {
+	fn(); // warmup
+	size_t iters  = 0;
+	size_t allocs = g_allocCount;
+	auto   start  = Clock::now();
+	double elapsed;
+	do {
+		fn();
+		iters++;
+		elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+	} while (elapsed < 0.05);
+	double ops      = (double) iters * (double) opsPerIter;
+	double nsPerOp  = 1e9 * elapsed / ops;
+	double allocsPO = (double) (g_allocCount - allocs) / ops;
+	bool   ok       = nsPerOp <= maxNsPerOp && allocsPO <= maxAllocsPerOp;
+	if (!ok)
+		g_failures++;
+	printf("%-46s %10.1f ns/op (max %8.0f) %8.3f allocs/op (max %6.2f)  %s\n",
+	       name, nsPerOp, maxNsPerOp, allocsPO, maxAllocsPerOp, ok ? "PASS" : "FAIL");
+}
+
+// Run 'fn' at two input sizes and fail if time grows superlinearly. A linear path
+// shows a ratio near sizeB/sizeA; quadratic shows (sizeB/sizeA)^2. The threshold
+// sits between the two, so it is insensitive to absolute machine speed.
+template <typename F>
+void Scaling(const char* name, size_t sizeA, size_t sizeB, double maxRatio, F fn) {
+	auto timeOne = [&fn](size_t size) {
+		fn(size); // warmup
+		size_t iters = 0;
+		auto   start = Clock::now();
+		double elapsed;
+		do {
+			fn(size);
+			iters++;
+			elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		} while (elapsed < 0.05);
+		return elapsed / (double) iters;
+	};
+	double a     = timeOne(sizeA);
+	double b     = timeOne(sizeB);
+	double ratio = b / a;
+	bool   ok    = ratio <= maxRatio;
+	if (!ok)
+		g_failures++;
+	printf("%-46s %zu -> %zu: %5.2fx (max %.1fx)  %s\n",
+	       name, sizeA, sizeB, ratio, maxRatio, ok ? "PASS" : "FAIL");
+}
+
+static argparse::Args* MakeArgs() {
+	auto args = new argparse::Args("fuzz [options...] files...\nA tool that exists to be abused by this harness.");
+	args->SetOutput(NullSink);
+	args->AddSwitch("f", "force", "Force a thing");
+	args->AddSwitch("v", "verbose", "Say more");
+	args->AddValue("o", "outfile", "File to write to");
+	args->AddValue("t", "timeout", "Timeout in seconds", "60");
+	args->AddValue("j", "jobs", "Worker count", "1");
+	return args;
+}
+
+// One multi-megabyte token, as a positional, an option value, and an unknown
+// option. All three must stay linear in the token length: the positional is one
+// string copy, the value one copy plus a numeric scan, and the unknown option
+// runs the error render and the did-you-mean probe against the giant name.
+static void HugeTokens() {
+	const size_t n     = 4 * 1024 * 1024;
+	std::string  token(n, 'x');
+	auto         args = MakeArgs();
+
+	const char* pos[2] = {"fuzz", token.c_str()};
+	Budget("huge token, positional (per byte)", n, 2.0, 0.001, [&args, &pos]() { args->Parse(2, pos); });
+
+	const char* val[3] = {"fuzz", "--outfile", token.c_str()};
+	Budget("huge token, option value (per byte)", n, 2.0, 0.001, [&args, &val]() { args->Parse(3, val); });
+
+	// The unknown-option path makes several linear passes over the token (lookup
+	// hash, numeric scan, error formatting, emit), so its per-byte budget is wider
+	std::string dashed = "--" + token;
+	const char* unk[2] = {"fuzz", dashed.c_str()};
+	Budget("huge token, unknown option (per byte)", n, 10.0, 0.001, [&args, &unk]() { args->Parse(2, unk); });
+
+	// Scaling in argc: 4x the positional tokens must cost about 4x, not 16x. Token
+	// bytes are covered by the absolute per-byte budgets above; this catches
+	// per-token work that rescans the whole argv or the definition. (Scaling over
+	// token size is not checked here, because a multi-megabyte copy times the
+	// allocator's large-block behavior more than it times the parser.)
+	std::vector<std::string> many(40000, std::string("some/positional/path.txt"));
+	std::vector<const char*> margv;
+	margv.push_back("fuzz");
+	for (size_t i = 0; i < many.size(); i++)
+		margv.push_back(many[i].c_str());
+	Scaling("positional count, scaling", 10000, 40000, 8.0, [&args, &margv](size_t size) {
+		args->Parse((int) size + 1, margv.data());
+	});
+	delete args;
+}
+
+// Storms of dash-heavy tokens: negative numbers (which must fall through to
+// positionals, running IsNumericToken over every byte), and unknown options of
+// random dash depth (which hit the suggestion probe and the error path)
+static void DashStorms() {
+	auto args = MakeArgs();
+	Rng  rng;
+
+	const size_t             numTokens = 10000;
+	std::vector<std::string> storage;
+	for (size_t i = 0; i < numTokens; i++) {
+		std::string t(1 + rng.Next(30), '-');
+		char        num[32];
+		snprintf(num, sizeof(num), "%u", rng.Next(1000000));
+		storage.push_back(t.substr(0, 1) + num); // "-123456": numeric, becomes positional
+	}
+	std::vector<const char*> argv;
+	argv.push_back("fuzz");
+	for (size_t i = 0; i < numTokens; i++)
+		argv.push_back(storage[i].c_str());
+	Budget("dash storm, negative numbers (per token)", numTokens, 300.0, 1.1, [&args, &argv]() {
+		args->Parse((int) argv.size(), argv.data());
+	});
+
+	// Unknown dash tokens abort the parse at the first one, so feed them one parse
+	// each: deep dash nesting, then a short garbage tail
+	std::vector<std::string> unknowns;
+	for (size_t i = 0; i < 200; i++) {
+		std::string t(1 + rng.Next(200), '-');
+		t += 'a' + (char) rng.Next(26);
+		unknowns.push_back(t);
+	}
+	Budget("dash storm, unknown options (per parse)", unknowns.size(), 30000.0, 40.0, [&args, &unknowns]() {
+		for (size_t i = 0; i < unknowns.size(); i++) {
+			const char* a[2] = {"fuzz", unknowns[i].c_str()};
+			args->Parse(2, a);
+		}
+	});
+	delete args;
+}
+
+// Giant help texts: a multi-hundred-KB summary must render linearly, even though
+// it is one unbroken word that the line wrapper can never split
+static void GiantHelp() {
+	Scaling("giant help text, scaling", 256 * 1024, 1024 * 1024, 8.0, [](size_t size) {
+		argparse::Args args("fuzz [options...]");
+		args.SetOutput(NullSink);
+		args.AddValue("o", "outfile", std::string(size, 'y'));
+		args.ShowHelp();
+	});
+}
+
+// Degenerate response files: megabytes of whitespace around a handful of tokens,
+// and a file that is one giant token
+static void ResponseFiles() {
+	const char*  fname = "argparse_fuzz_resp.txt";
+	const size_t n     = 4 * 1024 * 1024;
+	Rng          rng;
+	{
+		FILE*       f = fopen(fname, "wb");
+		std::string ws(1024, ' ');
+		for (size_t written = 0; written < n; written += ws.size() + 8) {
+			fwrite(ws.data(), 1, ws.size(), f);
+			fprintf(f, "token%02u ", rng.Next(100));
+		}
+		fclose(f);
+	}
+	auto args                 = MakeArgs();
+	args->ExpandResponseFiles = true;
+	const char* argv[2]       = {"fuzz", "@argparse_fuzz_resp.txt"};
+	Budget("response file, whitespace runs (per byte)", n, 3.0, 0.00001, [&args, &argv]() {
+		args->ParseStream(2, argv, [](const char*) { return true; });
+	});
+
+	{
+		FILE*       f = fopen(fname, "wb");
+		std::string giant(n, 'z');
+		fwrite(giant.data(), 1, giant.size(), f);
+		fclose(f);
+	}
+	Budget("response file, one giant token (per byte)", n, 3.0, 0.00001, [&args, &argv]() {
+		args->ParseStream(2, argv, [](const char*) { return true; });
+	});
+	delete args;
+	remove(fname);
+}
+
+// Random argv streams: tokens drawn from a dash/equals/at-heavy alphabet, thrown
+// at a definition with options and commands. The parse may succeed or fail, but
+// it must never crash, and the cost per token stays bounded.
+static void RandomArgv() {
+	argparse::Args args("fuzz [options...] <command>");
+	args.SetOutput(NullSink);
+	args.Quiet = true;
+	args.AddSwitch("f", "force", "Force a thing");
+	args.AddValue("o", "outfile", "File to write to");
+	auto cmdFoo = args.AddCommand("foo <src>", "Do the foo thing", [](argparse::Args&) { return 0; });
+	cmdFoo->AddSwitch("v", "verbose", "Say more");
+	args.AddCommand("bar", "Do the bar thing", [](argparse::Args&) { return 0; });
+
+	const char*  alphabet  = "--==@@//??ab.eE019 \t\nfoverbsluxz";
+	const size_t numParses = 2000;
+	Rng          rng;
+	Budget("random argv, mixed garbage (per parse)", numParses, 30000.0, 50.0, [&]() {
+		Rng local = rng; // same seed every iteration, so timing is stable
+		for (size_t p = 0; p < numParses; p++) {
+			std::string              storage[8];
+			std::vector<const char*> argv;
+			argv.push_back("fuzz");
+			size_t numTokens = 1 + local.Next(8);
+			for (size_t t = 0; t < numTokens; t++) {
+				std::string& tok = storage[t];
+				size_t       len = 1 + local.Next(24);
+				for (size_t c = 0; c < len; c++)
+					tok += alphabet[local.Next(32)];
+				argv.push_back(tok.c_str());
+			}
+			args.Parse((int) argv.size(), argv.data());
+		}
+	});
+}
+
+int main(int argc, char** argv) {
+	HugeTokens();
+	DashStorms();
+	GiantHelp();
+	ResponseFiles();
+	RandomArgv();
+	if (g_failures != 0) {
+		printf("\n%d input class(es) exceeded their budget\n", g_failures);
+		return 1;
+	}
+	printf("\nAll input classes within budget\n");
+	return 0;
+}
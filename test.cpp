@@ -43,6 +43,329 @@ void Simple() {
 	}
 }
 
+void StaticTable() {
+	static const argparse::OptionDef defs[] = {
+	    {"f", "force", "Force a thing", "", false},
+	    {"c", "count", "Max count", "7", true},
+	};
+	argparse::Args args("Usage: something [options...]", defs);
+
+	const char* a[4] = {"thing.exe", "-f", "--count", "9"};
+	assert(args.Parse(4, a));
+	assert(args.Has("force"));
+	assert(args.GetInt("count") == 9);
+
+	const char* b[2] = {"thing.exe", "-f"};
+	assert(args.Parse(2, b));
+	assert(args.GetInt("count") == 7); // default from the table
+
+	// Same table, registered in bulk after construction
+	argparse::Args args2("Usage: something [options...]");
+	args2.AddOptions({
+	    {"f", "force", "Force a thing", "", false},
+	    {"c", "count", "Max count", "7", true},
+	});
+	assert(args2.Parse(4, a));
+	assert(args2.Has("force"));
+	assert(args2.GetInt("count") == 9);
+}
+
+void Handles() {
+	argparse::Args args("Usage: something [options...]");
+	args.AddSwitch("f", "force", "Force a thing");
+	args.AddValue("c", "count", "Max count", "7");
+
+	auto hForce = args.Handle("force");
+	auto hCount = args.Handle("c");
+	assert(hForce.Valid() && hCount.Valid());
+
+	const char* a[4] = {"thing.exe", "-f", "--count", "9"};
+	assert(args.Parse(4, a));
+	assert(args.Has(hForce));
+	assert(args.Get(hCount) == "9");
+	assert(args.GetInt(hCount) == 9);
+	assert(args.GetInt64(hCount) == 9);
+	assert(args.GetDouble(hCount) == 9);
+}
+
+void TypedValues() {
+	argparse::Args args("Usage: something [options...]");
+	args.AddIntValue("j", "jobs", "Number of jobs", "4");
+	args.AddDoubleValue("s", "scale", "Scale factor", "1.5");
+
+	{
+		const char* a[3] = {"thing.exe", "--jobs", "32"};
+		assert(args.Parse(3, a));
+		assert(args.GetInt("jobs") == 32);
+		assert(args.GetInt64("j") == 32);
+		assert(args.GetDouble("scale") == 1.5);
+	}
+	{
+		// A malformed number fails the parse, instead of silently becoming 0
+		const char* a[3] = {"thing.exe", "--jobs", "banana"};
+		assert(!args.Parse(3, a));
+	}
+}
+
+#if ARGPARSE_HAS_STRING_VIEW
+void ZeroCopyMode() {
+	argparse::Args args("Usage: something [options...] params...");
+	args.AddValue("o", "outfile", "File to write to");
+	args.ZeroCopy = true;
+
+	const char* a[5] = {"thing.exe", "--outfile", "myfile", "pos1", "pos2"};
+	assert(args.Parse(5, a));
+	assert(args.GetView("outfile") == "myfile");
+	assert(args.GetView("outfile").data() == a[2]); // view points directly into argv
+	assert(args.ParamViews.size() == 2);
+	assert(args.ParamViews[0] == "pos1");
+	assert(args.Get("outfile") == "myfile"); // owning API still works in zero-copy mode
+
+	// Handle-based queries: GetView works in both modes, and Get(h) refuses to
+	// return the (empty) owning value when the real one lives in the view
+	auto h = args.Handle("outfile");
+	assert(args.GetView(h) == "myfile");
+	assert(args.GetView(h).data() == a[2]);
+	std::string captured;
+	args.SetOutput([&captured](const char* text, size_t len) { captured.append(text, len); });
+	assert(args.Get(h) == "");
+	assert(captured.find("GetView") != std::string::npos);
+
+	args.ZeroCopy = false;
+	assert(args.Parse(5, a));
+	assert(args.Get(h) == "myfile");
+	assert(args.GetView(h) == "myfile");
+}
+#endif
+
+void EnvConfigOverlay() {
+#ifdef _WIN32
+	_putenv_s("ARGPARSE_TEST_OUTFILE", "envfile");
+#else
+	setenv("ARGPARSE_TEST_OUTFILE", "envfile", 1);
+#endif
+
+	argparse::Args args("Usage: something [options...]");
+	args.AddValue("o", "outfile", "File to write to");
+	args.AddIntValue("j", "jobs", "Number of jobs", "4");
+	args.SetEnvVar("outfile", "ARGPARSE_TEST_OUTFILE");
+	args.SetConfigKey("outfile", "out.file");
+	args.SetConfigKey("jobs", "build.jobs");
+	args.SetConfigSource([](const std::string& key, std::string& value) {
+		if (key == "build.jobs") {
+			value = "9";
+			return true;
+		}
+		if (key == "out.file") {
+			value = "cfgfile";
+			return true;
+		}
+		return false;
+	});
+
+	{
+		// argv beats everything
+		const char* a[3] = {"thing.exe", "--outfile", "argfile"};
+		assert(args.Parse(3, a));
+		assert(args.Get("outfile") == "argfile");
+		assert(args.GetSource("outfile") == argparse::ValueSource::CommandLine);
+		// env beats config, config beats the default
+		assert(args.GetInt("jobs") == 9);
+		assert(args.GetSource("jobs") == argparse::ValueSource::Config);
+	}
+	{
+		const char* a[1] = {"thing.exe"};
+		assert(args.Parse(1, a));
+		assert(args.Has("outfile"));
+		assert(args.Get("outfile") == "envfile");
+		assert(args.GetSource("outfile") == argparse::ValueSource::Env);
+
+		// ParseTo resolves the same overlay into the result
+		argparse::ParseResult res;
+		assert(args.ParseTo(1, a, res));
+		assert(res.Root.Get("outfile") == "envfile");
+		assert(res.Root.GetSource("outfile") == argparse::ValueSource::Env);
+		assert(res.Root.GetInt("jobs") == 9);
+	}
+
+#ifdef _WIN32
+	_putenv_s("ARGPARSE_TEST_OUTFILE", "");
+#else
+	unsetenv("ARGPARSE_TEST_OUTFILE");
+#endif
+	{
+		// With the variable gone, the config key takes over
+		const char* a[1] = {"thing.exe"};
+		assert(args.Parse(1, a));
+		assert(args.Get("outfile") == "cfgfile");
+		assert(args.GetSource("outfile") == argparse::ValueSource::Config);
+	}
+	{
+		// A malformed number from the overlay fails the parse, like argv does
+		argparse::Args bad("Usage: something [options...]");
+		bad.AddIntValue("j", "jobs", "Number of jobs", "4");
+		bad.SetConfigKey("jobs", "build.jobs");
+		bad.SetConfigSource([](const std::string&, std::string& value) {
+			value = "banana";
+			return true;
+		});
+		const char* a[1] = {"thing.exe"};
+		assert(!bad.Parse(1, a));
+	}
+}
+
+void Reparse() {
+	argparse::Args args("Usage: something [options...]");
+	args.AddSwitch("f", "force", "Force a thing");
+	args.AddValue("c", "count", "Max count", "7");
+	args.AddIntValue("j", "jobs", "Number of jobs", "4");
+
+	{
+		const char* a[5] = {"thing.exe", "-f", "--count", "9", "pos1"};
+		assert(args.Parse(5, a));
+		assert(args.Has("force"));
+		assert(args.GetInt("count") == 9);
+		assert(args.GetInt("jobs") == 4);
+	}
+	{
+		// Nothing from the previous parse may leak into this one
+		const char* a[3] = {"thing.exe", "--jobs", "5"};
+		assert(args.Parse(3, a));
+		assert(!args.Has("force"));
+		assert(args.GetInt("count") == 7);
+		assert(args.GetInt("jobs") == 5);
+		assert(args.Params.size() == 0);
+	}
+	{
+		// An empty parse restores every default
+		const char* a[1] = {"thing.exe"};
+		assert(args.Parse(1, a));
+		assert(!args.Has("force"));
+		assert(args.GetInt("count") == 7);
+		assert(args.GetInt("jobs") == 4);
+	}
+}
+
+void InlineAndBundled() {
+	argparse::Args args("Usage: something [options...] params...");
+	args.AddSwitch("f", "force", "Force a thing");
+	args.AddSwitch("p", "preserve", "Preserve goodness");
+	args.AddValue("o", "outfile", "File to write to");
+	args.AddIntValue("j", "jobs", "Number of jobs", "4");
+
+	{
+		// --opt=value, and bundled short switches
+		const char* a[4] = {"thing.exe", "--jobs=32", "-fp", "pos1"};
+		assert(args.Parse(4, a));
+		assert(args.GetInt("jobs") == 32);
+		assert(args.Has("force") && args.Has("preserve"));
+		assert(args.Params.size() == 1);
+	}
+	{
+		// The last option of a bundle may take a value
+		const char* a[3] = {"thing.exe", "-fo", "myfile"};
+		assert(args.Parse(3, a));
+		assert(args.Has("force"));
+		assert(args.Get("outfile") == "myfile");
+	}
+	{
+		// A switch does not take an inline value
+		const char* a[2] = {"thing.exe", "--force=1"};
+		assert(!args.Parse(2, a));
+	}
+	{
+		// A bundle containing an unknown letter is an unknown option
+		const char* a[2] = {"thing.exe", "-fx"};
+		assert(!args.Parse(2, a));
+	}
+	{
+		// A value option inside a bundle must come last
+		const char* a[3] = {"thing.exe", "-of", "myfile"};
+		assert(!args.Parse(3, a));
+	}
+
+#if ARGPARSE_HAS_STRING_VIEW
+	args.ZeroCopy = true;
+	const char* a[2] = {"thing.exe", "--outfile=myfile"};
+	assert(args.Parse(2, a));
+	assert(args.GetView("outfile") == "myfile");
+	assert(args.GetView("outfile").data() == a[1] + 10); // view points into the argv token, after the '='
+	args.ZeroCopy = false;
+#endif
+}
+
+void MultiValues() {
+	argparse::Args args("Usage: something [options...]");
+	args.AddMultiValue("I", "include", "Add an include path");
+	args.AddValue("o", "outfile", "File to write to");
+
+	const char* a[7] = {"thing.exe", "-I", "aa", "--include", "bb", "-I", "cc"};
+	assert(args.Parse(7, a));
+	assert(args.Has("include"));
+	auto& all = args.GetAll("include");
+	assert(all.size() == 3);
+	assert(all[0] == "aa" && all[1] == "bb" && all[2] == "cc");
+	assert(args.GetAll(args.Handle("I")).size() == 3);
+
+	// Re-parsing starts the accumulation afresh
+	const char* b[3] = {"thing.exe", "-I", "dd"};
+	assert(args.Parse(3, b));
+	assert(args.GetAll("include").size() == 1);
+	assert(args.GetAll("include")[0] == "dd");
+
+	// ParseTo accumulates into the result instead of the definition
+	argparse::ParseResult res;
+	assert(args.ParseTo(7, a, res));
+	assert(res.Root.GetAll("include").size() == 3);
+	assert(res.Root.GetAll("include")[2] == "cc");
+	assert(args.GetAll("include").size() == 1);
+
+#if ARGPARSE_HAS_STRING_VIEW
+	args.ZeroCopy = true;
+	assert(args.Parse(7, a));
+	assert(args.GetAllViews("include").size() == 3);
+	assert(args.GetAllViews("include")[0].data() == a[2]); // views point directly into argv
+	args.ZeroCopy = false;
+#endif
+}
+
+void FixedCapacity() {
+	argparse::FixedArgs<4, 2> args;
+	assert(args.AddSwitch("f", "force"));
+	assert(args.AddValue("o", "outfile"));
+	assert(args.AddValue("c", "count", "7"));
+	assert(args.AddSwitch("", "justlong"));
+
+	{
+		// A lone "-" (the conventional stdin placeholder) is a positional, and must
+		// not match the empty short name of --justlong
+		const char* b[2] = {"thing.exe", "-"};
+		assert(args.Parse(2, b));
+		assert(!args.Has("justlong"));
+		assert(args.NumParams == 1);
+		assert(strcmp(args.Params[0], "-") == 0);
+	}
+
+	const char* a[6] = {"thing.exe", "-f", "--outfile", "myfile", "pos1", "pos2"};
+	assert(args.Parse(6, a));
+	assert(args.Has("f"));
+	assert(!args.Has("count"));
+	assert(args.Get("outfile") == a[3]); // value points directly into argv
+	assert(args.GetInt("count") == 7);
+	assert(args.NumParams == 2);
+	assert(strcmp(args.Params[1], "pos2") == 0);
+
+	{
+		const char* b[2] = {"thing.exe", "-bad"};
+		assert(!args.Parse(2, b));
+	}
+	{
+		// One parameter more than the fixed capacity fails the parse
+		const char* b[4] = {"thing.exe", "pos1", "pos2", "pos3"};
+		assert(!args.Parse(4, b));
+	}
+}
+
 int Foo(argparse::Args& args) {
 	printf("Foo %s\n", args.Has("foo1") ? "foo1" : "nothing");
 	return 0;
@@ -63,6 +386,12 @@ void WithCommands() {
 
 	auto cmdBar = args.AddCommand("bar", "Do the bar thing", Bar);
 
+	assert(args.FindCommand("foo") == cmdFoo);
+	assert(args.FindCommand("fo") == nullptr);
+	auto pre = args.FindCommandsByPrefix("f");
+	assert(pre.size() == 1 && pre[0] == cmdFoo);
+	assert(args.FindCommandsByPrefix("").size() == 2);
+
 	{
 		const char* a[2] = {"thing.exe", "nop"};
 		assert(!args.Parse(2, a));
@@ -87,8 +416,499 @@ void WithCommands() {
 	}
 }
 
+void LazyCommands() {
+	argparse::Args args("thing [options...] <command>");
+
+	int setupCalls = 0;
+	auto cmdFoo = args.AddCommand("foo", "Do the foo thing", Foo, [&setupCalls](argparse::Args& cmd) {
+		setupCalls++;
+		cmd.AddSwitch("f", "foo1", "foo1 switch");
+	});
+	args.AddCommand("bar", "Do the bar thing", Bar, [](argparse::Args& cmd) {
+		assert(false); // never chosen, so never set up
+	});
+
+	assert(setupCalls == 0);
+	{
+		const char* a[3] = {"thing.exe", "foo", "--foo1"};
+		assert(args.Parse(3, a));
+		assert(setupCalls == 1);
+		assert(args.WhichCommand() == cmdFoo);
+		assert(cmdFoo->Has("foo1"));
+	}
+	{
+		// Setup runs at most once
+		const char* a[2] = {"thing.exe", "foo"};
+		assert(args.Parse(2, a));
+		assert(setupCalls == 1);
+	}
+}
+
+void ParseResults() {
+	argparse::Args args("thing [options...] <command>");
+	args.AddSwitch("v", "verbose", "More verbose");
+	args.AddValue("c", "count", "Max count", "7");
+	auto cmdFoo = args.AddCommand("foo", "Do the foo thing", Foo);
+	cmdFoo->AddSwitch("f", "foo1", "foo1 switch");
+
+	argparse::ParseResult res;
+	{
+		const char* a[6] = {"thing.exe", "-v", "--count", "9", "foo", "--foo1"};
+		assert(args.ParseTo(6, a, res));
+		assert(res.Root.Has("verbose"));
+		assert(res.Root.Get("count") == "9");
+		assert(res.Root.GetInt("count") == 9);
+		assert(res.Command == cmdFoo);
+		assert(res.Cmd.Has("foo1"));
+	}
+	{
+		// ParseTo leaves the definition untouched, so the previous result remains
+		// valid across subsequent parses
+		argparse::ParseResult res2;
+		const char* a[2] = {"thing.exe", "foo"};
+		assert(args.ParseTo(2, a, res2));
+		assert(!res2.Root.Has("verbose"));
+		assert(res2.Root.GetInt("count") == 7);
+		assert(res.Root.GetInt("count") == 9);
+		assert(!args.Has("verbose")); // Option objects were not mutated
+	}
+}
+
+void Streaming() {
+	argparse::Args args("Usage: something [options...] files...");
+	args.AddSwitch("f", "force", "Force a thing");
+
+	std::vector<std::string> seen;
+	const char*              a[5] = {"thing.exe", "-f", "pos1", "pos2", "pos3"};
+	assert(args.ParseStream(5, a, [&seen](const char* param) {
+		seen.push_back(param);
+		return true;
+	}));
+	assert(args.Has("force"));
+	assert(seen.size() == 3);
+	assert(seen[0] == "pos1" && seen[2] == "pos3");
+	assert(args.Params.size() == 0); // nothing was accumulated
+
+	// Returning false from the callback aborts the parse
+	int count = 0;
+	assert(!args.ParseStream(5, a, [&count](const char*) { return ++count < 2; }));
+	assert(count == 2);
+}
+
+void ResponseFiles() {
+	const char* fname = "argparse_test_resp.txt";
+	FILE*       f     = fopen(fname, "wb");
+	assert(f);
+	fprintf(f, "--outfile myfile\npos1\t pos2\n");
+	fclose(f);
+
+	argparse::Args args("Usage: something [options...] files...");
+	args.AddValue("o", "outfile", "File to write to");
+	args.ExpandResponseFiles = true;
+
+	const char* a[3] = {"thing.exe", "-o", "ignored"};
+	const char* b[2] = {"thing.exe", "@argparse_test_resp.txt"};
+	assert(args.Parse(2, b));
+	assert(args.Get("outfile") == "myfile");
+	assert(args.Params.size() == 2);
+	assert(args.Params[0] == "pos1");
+	assert(args.Params[1] == "pos2");
+
+	// A large file with long whitespace runs, to exercise the vectorized scans
+	f = fopen(fname, "wb");
+	assert(f);
+	for (int i = 0; i < 100; i++)
+		fprintf(f, "param-number-%03d%s", i, i % 3 == 0 ? "   \t\t \r\n  " : "\n");
+	fclose(f);
+	assert(args.Parse(2, b));
+	assert(args.Params.size() == 100);
+	assert(args.Params[0] == "param-number-000");
+	assert(args.Params[99] == "param-number-099");
+
+	// A missing response file fails the parse
+	const char* c[2] = {"thing.exe", "@no_such_file_here"};
+	assert(!args.Parse(2, c));
+
+	// Plain argv still works with expansion enabled
+	assert(args.Parse(3, a));
+	assert(args.Get("outfile") == "ignored");
+
+	remove(fname);
+}
+
+void Completion() {
+	argparse::Args args("thing [options...] <command>");
+	args.AddSwitch("v", "verbose", "More verbose");
+	auto cmdFoo = args.AddCommand("foo", "Do the foo thing", Foo);
+	cmdFoo->AddSwitch("f", "foo1", "foo1 switch");
+	args.AddCommand("bar", "Do the bar thing", Bar);
+
+	auto cmds = args.Complete("");
+	assert(cmds.size() == 2 && cmds[0] == "bar" && cmds[1] == "foo");
+	assert(args.Complete("f").size() == 1 && args.Complete("f")[0] == "foo");
+	assert(args.Complete("z").size() == 0);
+
+	auto opts = args.Complete("--");
+	assert(opts.size() == 1 && opts[0] == "--verbose");
+	assert(args.Complete("--v")[0] == "--verbose");
+	assert(cmdFoo->Complete("--f")[0] == "--foo1");
+
+	std::string captured;
+	args.SetOutput([&captured](const char* text, size_t len) {
+		captured.append(text, len);
+	});
+	{
+		const char* a[3] = {"thing.exe", "--complete", "fo"};
+		assert(args.TryComplete(3, a));
+		assert(captured == "foo\n");
+	}
+	{
+		// A command word earlier in the line moves the query into that command
+		captured.clear();
+		const char* a[4] = {"thing.exe", "--complete", "foo", "--f"};
+		assert(args.TryComplete(4, a));
+		assert(captured == "--foo1\n");
+	}
+	{
+		// Not a completion query
+		const char* a[2] = {"thing.exe", "foo"};
+		assert(!args.TryComplete(2, a));
+	}
+
+	assert(args.BashCompletionScript("thing").find("--complete") != std::string::npos);
+	assert(args.ZshCompletionScript("thing").find("#compdef thing") != std::string::npos);
+}
+
+void Suggestions() {
+	argparse::Args args("Usage: something [options...]");
+	args.AddSwitch("v", "verbose", "More verbose");
+	args.AddValue("o", "outfile", "File to write to");
+
+	std::string captured;
+	args.SetOutput([&captured](const char* text, size_t len) {
+		captured.append(text, len);
+	});
+
+	{
+		const char* a[2] = {"thing.exe", "--outfle"};
+		assert(!args.Parse(2, a));
+		assert(captured.find("Did you mean") != std::string::npos);
+		assert(captured.find("--outfile") != std::string::npos);
+	}
+	{
+		// Nothing within edit distance 2, so no suggestion
+		captured.clear();
+		const char* a[2] = {"thing.exe", "--zzzzzz"};
+		assert(!args.Parse(2, a));
+		assert(captured.find("Unknown option") != std::string::npos);
+		assert(captured.find("Did you mean") == std::string::npos);
+	}
+	{
+		// The name part of --opt=value is what gets probed
+		captured.clear();
+		const char* a[2] = {"thing.exe", "--outfiel=x"};
+		assert(!args.Parse(2, a));
+		assert(captured.find("--outfile") != std::string::npos);
+	}
+
+	argparse::Args cargs("thing [options...] <command>");
+	cargs.AddCommand("foo", "Do the foo thing", Foo);
+	cargs.AddCommand("bar", "Do the bar thing", Bar);
+	cargs.SetOutput([&captured](const char* text, size_t len) {
+		captured.append(text, len);
+	});
+	captured.clear();
+	const char* a[2] = {"thing.exe", "fop"};
+	assert(!cargs.Parse(2, a));
+	assert(captured.find("Did you mean") != std::string::npos);
+	assert(captured.find("foo") != std::string::npos);
+}
+
+void SchemaRoundTrip() {
+	const char* fname = "argparse_test_schema.bin";
+
+	argparse::Args src("Usage: something [options...] <command>");
+	src.AddSwitch("f", "force", "Force a thing");
+	src.AddIntValue("j", "jobs", "Number of jobs", "4");
+	src.AddMultiValue("I", "include", "Add an include path");
+	src.SetEnvVar("jobs", "ARGPARSE_TEST_JOBS");
+	auto cmdFoo = src.AddCommand("foo <src> <dst>", "Do the foo thing", Foo);
+	cmdFoo->AddSwitch("v", "verbose", "More verbose");
+	assert(src.SaveSchema(fname));
+
+	argparse::Args dst("");
+	assert(dst.LoadSchema(fname));
+	assert(dst.Usage == src.Usage);
+
+	// Command functions are code, not data; re-attach after loading
+	auto dstFoo = dst.FindCommand("foo");
+	assert(dstFoo != nullptr);
+	dstFoo->CmdFunc = Foo;
+
+	const char* a[6] = {"thing.exe", "-f", "foo", "--verbose", "p1", "p2"};
+	assert(dst.Parse(6, a));
+	assert(dst.Has("force"));
+	assert(dst.GetInt("jobs") == 4);
+	assert(dst.WhichCommand() == dstFoo);
+	assert(dstFoo->Has("verbose"));
+	assert(dst.ExecCommand() == 0);
+
+	{
+		// Wrong parameter count is still enforced on the loaded command
+		const char* b[4] = {"thing.exe", "foo", "--verbose", "p1"};
+		assert(!dst.Parse(4, b));
+	}
+	{
+		// Garbage is rejected
+		FILE* f = fopen(fname, "wb");
+		fprintf(f, "not a schema");
+		fclose(f);
+		argparse::Args bad("");
+		assert(!bad.LoadSchema(fname));
+	}
+
+	remove(fname);
+}
+
+void QuietErrors() {
+	argparse::Args args("Usage: something [options...]");
+	args.AddValue("o", "outfile", "File to write to");
+	args.AddIntValue("j", "jobs", "Number of jobs", "4");
+	args.Quiet = true;
+
+	std::string captured;
+	args.SetOutput([&captured](const char* text, size_t len) {
+		captured.append(text, len);
+	});
+
+	{
+		const char* a[2] = {"thing.exe", "--outfle"};
+		assert(!args.Parse(2, a));
+		assert(captured.empty()); // quiet: nothing rendered, nothing written
+		assert(args.LastError.Code == argparse::ErrorCode::UnknownOption);
+		assert(args.LastError.ArgIndex == 1);
+		assert(strcmp(args.LastError.Token, "--outfle") == 0);
+		// Formatting happens only on demand, suggestions included
+		std::string msg = args.FormatError();
+		assert(msg.find("Unknown option") != std::string::npos);
+		assert(msg.find("--outfile") != std::string::npos);
+	}
+	{
+		const char* a[2] = {"thing.exe", "--outfile"};
+		assert(!args.Parse(2, a));
+		assert(args.LastError.Code == argparse::ErrorCode::MissingValue);
+		assert(args.LastError.OptionIndex == 0);
+		assert(args.FormatError().find("expects a value") != std::string::npos);
+	}
+	{
+		const char* a[3] = {"thing.exe", "--jobs", "banana"};
+		assert(!args.Parse(3, a));
+		assert(args.LastError.Code == argparse::ErrorCode::BadValue);
+		assert(args.FormatError().find("banana") != std::string::npos);
+	}
+	{
+		// A successful parse clears the previous error
+		const char* a[3] = {"thing.exe", "--jobs", "5"};
+		assert(args.Parse(3, a));
+		assert(args.LastError.Code == argparse::ErrorCode::None);
+	}
+	assert(captured.empty());
+
+	// Unknown command, through ParseTo, also lands in LastError
+	argparse::Args cargs("thing [options...] <command>");
+	cargs.AddCommand("foo", "Do the foo thing", Foo);
+	cargs.Quiet = true;
+	cargs.SetOutput([&captured](const char* text, size_t len) {
+		captured.append(text, len);
+	});
+	argparse::ParseResult res;
+	const char* a[2] = {"thing.exe", "nop"};
+	assert(!cargs.ParseTo(2, a, res));
+	assert(captured.empty());
+	assert(cargs.LastError.Code == argparse::ErrorCode::UnknownCommand);
+	assert(cargs.FormatError().find("Unknown command") != std::string::npos);
+
+	// Errors raised in a chosen command's scope honor the root's Quiet too, even
+	// when Quiet was set after the command was added
+	argparse::Args cargs2("thing [options...] <command>");
+	auto           cmdFoo = cargs2.AddCommand("foo", "Do the foo thing", [](argparse::Args&) { return 0; });
+	cmdFoo->AddIntValue("j", "jobs", "Worker count", "1");
+	cargs2.Quiet = true;
+	std::string captured2;
+	cargs2.SetOutput([&captured2](const char* text, size_t len) {
+		captured2.append(text, len);
+	});
+	const char* b[4] = {"thing.exe", "foo", "--jobs", "banana"};
+	assert(!cargs2.Parse(4, b));
+	assert(captured2.empty());
+	assert(cargs2.LastError.Code == argparse::ErrorCode::BadValue);
+
+	argparse::ParseResult res2;
+	assert(!cargs2.ParseTo(4, b, res2));
+	assert(captured2.empty());
+	assert(cargs2.LastError.Code == argparse::ErrorCode::BadValue);
+}
+
+void ParallelParams() {
+	// Build an argv with an option region, then a run long enough to trigger the
+	// parallel positional path (>= ParallelMinRun tokens)
+	size_t                   n = argparse::Args::ParallelMinRun + 100;
+	std::vector<std::string> storage;
+	storage.reserve(n);
+	char buf[64];
+	for (size_t i = 0; i < n; i++) {
+		snprintf(buf, sizeof(buf), "path/%06d.txt", (int) i);
+		storage.push_back(buf);
+	}
+	std::vector<const char*> argv;
+	argv.push_back("thing.exe");
+	argv.push_back("-f");
+	for (size_t i = 0; i < n; i++)
+		argv.push_back(storage[i].c_str());
+	argv.push_back("--outfile");
+	argv.push_back("myfile");
+
+	argparse::Args args("Usage: something [options...] files...");
+	args.AddSwitch("f", "force", "Force a thing");
+	args.AddValue("o", "outfile", "File to write to");
+	args.ParallelParamThreads = 4;
+
+	assert(args.Parse((int) argv.size(), argv.data()));
+	assert(args.Has("force"));
+	assert(args.Get("outfile") == "myfile");
+	assert(args.Params.size() == n);
+	assert(args.Params[0] == storage[0]);
+	assert(args.Params[n / 2] == storage[n / 2]);
+	assert(args.Params[n - 1] == storage[n - 1]);
+
+#if ARGPARSE_HAS_STRING_VIEW
+	args.ZeroCopy = true;
+	assert(args.Parse((int) argv.size(), argv.data()));
+	assert(args.ParamViews.size() == n);
+	assert(args.ParamViews[n - 1] == storage[n - 1]);
+	assert(args.ParamViews[0].data() == argv[2]); // views still point into argv
+	args.ZeroCopy = false;
+#endif
+
+	// ParseTo and ParseStream take the same decision, with the same ordering
+	argparse::ParseResult res;
+	assert(args.ParseTo((int) argv.size(), argv.data(), res));
+	assert(res.Root.Params.size() == n);
+	assert(res.Root.Params[n / 2] == storage[n / 2]);
+
+	size_t seen = 0;
+	assert(args.ParseStream((int) argv.size(), argv.data(), [&seen](const char*) {
+		seen++;
+		return true;
+	}));
+	assert(seen == n);
+}
+
+#ifdef _WIN32
+void WideArgv() {
+	argparse::Args args("Usage: something [options...] params...");
+	args.AddSwitch("f", "force", "Force a thing");
+	args.AddValue("o", "outfile", "File to write to");
+
+	const wchar_t* a[5] = {L"thing.exe", L"-f", L"--outfile", L"myfile", L"pos1"};
+	assert(args.Parse(5, a));
+	assert(args.Has("force"));
+	assert(args.Get("outfile") == "myfile");
+	assert(args.Params.size() == 1);
+	assert(args.Params[0] == "pos1");
+
+#if ARGPARSE_HAS_STRING_VIEW
+	// Zero-copy views point into the internal conversion buffer, which stays alive
+	// until the next wide parse
+	args.ZeroCopy = true;
+	assert(args.Parse(5, a));
+	assert(args.ParamViews.size() == 1);
+	assert(args.ParamViews[0] == "pos1");
+	args.ZeroCopy = false;
+#endif
+}
+#endif
+
+void OutputSink() {
+	argparse::Args args("Usage: something [options...]");
+	args.AddSwitch("f", "force", "Force a thing");
+
+	std::string captured;
+	args.SetOutput([&captured](const char* text, size_t len) {
+		captured.append(text, len);
+	});
+
+	args.ShowHelp();
+	assert(captured.find("--force") != std::string::npos);
+
+	captured.clear();
+	const char* a[2] = {"thing.exe", "-bad"};
+	assert(!args.Parse(2, a));
+	assert(captured.find("Unknown option") != std::string::npos);
+}
+
+void ArenaCommands() {
+	argparse::Arena arena;
+	argparse::Args  args("thing [options...] <command>");
+	args.SetArena(&arena);
+
+	auto cmdFoo = args.AddCommand("foo", "Do the foo thing", Foo);
+	cmdFoo->AddSwitch("f", "foo1", "foo1 switch");
+	args.AddCommand("bar", "Do the bar thing", Bar);
+
+	const char* a[3] = {"thing.exe", "foo", "--foo1"};
+	assert(args.Parse(3, a));
+	assert(args.WhichCommand() == cmdFoo);
+	assert(cmdFoo->Has("foo1"));
+}
+
+#ifdef ARGPARSE_STATS
+void StatsCounters() {
+	argparse::Args args("Usage: something [options...] files...");
+	args.AddValue("o", "outfile", "File to write to");
+
+	const char* a[5] = {"thing.exe", "--outfile", "myfile", "pos1", "pos2"};
+	assert(args.Parse(5, a));
+	assert(args.Stats.Tokens == 4);
+	assert(args.Stats.OptionHits == 1);
+	assert(args.Stats.OptionMisses == 0);
+	assert(args.Stats.Params == 2);
+	assert(args.Stats.ParamBytes == 8);
+	assert(args.Stats.ValueBytes == 6);
+	assert(args.Stats.ParseSeconds > 0);
+}
+#endif
+
 int main(int argc, char** argv) {
 	Simple();
+	StaticTable();
+	TypedValues();
+	Handles();
+	Reparse();
+	EnvConfigOverlay();
+	InlineAndBundled();
+	MultiValues();
+	FixedCapacity();
+#if ARGPARSE_HAS_STRING_VIEW
+	ZeroCopyMode();
+#endif
 	WithCommands();
+	ArenaCommands();
+	ParseResults();
+	Streaming();
+#ifdef ARGPARSE_STATS
+	StatsCounters();
+#endif
+	ResponseFiles();
+	LazyCommands();
+	Completion();
+	Suggestions();
+	SchemaRoundTrip();
+	ParallelParams();
+#ifdef _WIN32
+	WideArgv();
+#endif
+	QuietErrors();
+	OutputSink();
 	return 0;
 }
\ No newline at end of file